@@ -21,8 +21,10 @@
 #include <fcntl.h>
 #include <err.h>
 #include <getopt.h>
-#include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/file.h>
+#include <limits.h>
+#include <sys/wait.h>
 #include <errno.h>
 
 #define DEFAULTS_PORT                "/dev/ttyUSB0"
@@ -32,25 +34,144 @@
 
 #define FLAG_DEBUG  (1U << 0)
 #define FLAG_ERASE  (1U << 1)
+#define FLAG_AUTO_BAUD  (1U << 2)
+#define FLAG_SPEED_SET  (1U << 3)
+#define FLAG_DOWNSHIFT  (1U << 4)
+#define FLAG_QUEUE      (1U << 5)
+#define FLAG_RX_THREAD  (1U << 6)
+#define FLAG_VERIFY_IMAGE (1U << 7)
+
+/* highest rate tried by --auto-baud unless limited by --speed */
+#define AUTO_BAUD_MAX               4000000
+/* checks a negotiated rate has to pass */
+#define AUTO_BAUD_PINGS             8
+/* file holding the last negotiated rate and chip family per adapter */
+#define BAUD_CACHE_NAME             "stc8prog.baud"
+/* longest adapter key in the baud cache, keys are escaped to one word */
+#define ADAPTER_KEY_MAX             511
+#define STRINGIFY_(x)               #x
+#define STRINGIFY(x)                STRINGIFY_(x)
+#define ADAPTER_KEY_SCAN            "%" STRINGIFY(ADAPTER_KEY_MAX) "s"
 
 /* retry reset chip, if it not responce after reset cycle */
 #define RESET_RETRY_COUNT           3
 /* chip detect 100ms try count before timeout */
 #define CHIP_DETECT_RST_TRYCOUNT    (uint16_t)(0x20)
 #define CHIP_DETECT_WAIT_TRYCOUNT   (uint16_t)(0x7FF)
+/* power cycle wait at handshake rates above the minimum */
+#define CHIP_DETECT_FAST_TRYCOUNT   (uint16_t)(0x200)
 
 /* length of the array containing the args of the reset cmd */
 #define LEN_RESET_ARGS 32
 
+/* maximum count of ports programmed at once */
+#define GANG_PORTS_MAX              16
+
+/* programming settings shared by all ports */
+typedef struct {
+    unsigned long flags;
+    unsigned int speed;
+    unsigned int handshake_speed;
+    unsigned int block_size;
+    unsigned int window;
+    uint32_t reset_time;
+    char *reset_cmd;
+    char **reset_args;
+    char *file;
+    char *chip_db;
+    char *compile;
+    char *target;
+    int hex_size;
+} prog_config_t;
+
+/* loaded firmware and session of the port programmed by this process */
+static stc_image_t image;
+/* write frames of the image, built before gang ports are forked */
+static stc_frames_t frames;
+/* compiled image, taking the place of both when -f names one */
+static stc_compiled_t compiled;
+static stc_session_t prog_session;
+
+/* last negotiated rate and detected chip family of an adapter */
+typedef struct {
+    unsigned int speed;
+    uint16_t protocol;
+    unsigned int ceiling;       /* slowest rate the chip took but the
+                                   line did not carry, 0 if none */
+} adapter_profile_t;
+
+/* what a chip is invited with again while negotiating the rate */
+static struct {
+    const prog_config_t *cfg;
+    unsigned int handshake;     /* rate the chip answered at */
+    const char *key;
+    adapter_profile_t *profile;
+} reinvite_ctx;
+
+/* output of a gang child process and the stdout it is copied to */
+static FILE *gang_log;
+static int gang_stdout = -1;
+
+/* long options without short equivalent */
+enum {
+    OPT_REPORT = 0x100,
+    OPT_HANDSHAKE_SPEED,
+    OPT_DOWNSHIFT,
+    OPT_QUEUE_WRITES,
+    OPT_RX_THREAD,
+    OPT_CHIP_DB,
+    OPT_COMPILE,
+    OPT_TARGET,
+    OPT_VERIFY_IMAGE,
+};
+
+/* programming phases timed for the report */
+typedef enum {
+    PHASE_DETECT = 0,
+    PHASE_BAUD_SWITCH,
+    PHASE_BAUD_CHECK,
+    PHASE_ERASE,
+    PHASE_WRITE,
+    PHASE_COUNT,
+} phase_t;
+
+static const char * const phase_names[PHASE_COUNT] = {
+    "detect", "baud_switch", "baud_check", "erase", "write",
+};
+
+/* run summary appended to the --report file on exit */
+static struct {
+    const char *path;
+    const char *port;
+    const char *model;
+    unsigned int speed;
+    int size;
+    bool ok;
+    uint64_t start_us;
+    uint64_t phase_us[PHASE_COUNT];
+} report;
+
 static const struct option options[] = {
     {"help",        no_argument,        0,  'h'},
     {"port",        required_argument,  0,  'p'},
     {"speed",       required_argument,  0,  's'},
+    {"auto-baud",   no_argument,        0,  'a'},
     {"reset",       required_argument,  0,  'r'},
     {"flash",       required_argument,  0,  'f'},
+    {"block",       required_argument,  0,  'b'},
+    {"window",      required_argument,  0,  'w'},
     {"erase",       no_argument,        0,  'e'},
     {"debug",       no_argument,        0,  'e'},
     {"version",     no_argument,        0,  'v'},
+    {"report",      required_argument,  0,  OPT_REPORT},
+    {"handshake-speed", required_argument, 0, OPT_HANDSHAKE_SPEED},
+    {"downshift",   no_argument,        0,  OPT_DOWNSHIFT},
+    {"queue-writes", no_argument,       0,  OPT_QUEUE_WRITES},
+    {"rx-thread",   no_argument,        0,  OPT_RX_THREAD},
+    {"chip-db",     required_argument,  0,  OPT_CHIP_DB},
+    {"compile",     required_argument,  0,  OPT_COMPILE},
+    {"target",      required_argument,  0,  OPT_TARGET},
+    {"verify-image", no_argument,       0,  OPT_VERIFY_IMAGE},
     { }, /* NULL */
 };
 
@@ -58,14 +179,35 @@ static void usage(void)
 {
     printf("Usage: stc8prog [options]...\n");
     printf("  -h, --help                    display this message\n");
-    printf("  -p, --port <device>           set device path\n");
+    printf("  -p, --port <device>           set device path, repeat to program up to %d\n", GANG_PORTS_MAX);
+    printf("                                devices in parallel\n");
     printf("  -s, --speed <baud>            set download baudrate\n");
+    printf("  -a, --auto-baud               use the fastest baudrate the chip passes, up to\n");
+    printf("                                --speed, and remember it for the adapter\n");
     printf("  -r, --reset <msec>            make reset sequence by pulling low dtr\n");
     printf("  -r, --reset <cmd> [args] ;    command to perform reset or power cycle\n");
     printf("  -f, --flash <file>            flash chip with data from hex file\n");
+    printf("  -b, --block <bytes>           set flash write block size, 1-%d (default %d)\n",
+           FLASH_BLOCK_MAX, FLASH_BLOCK_DEFAULT);
+    printf("  -w, --window <frames>         send up to 1-%d write frames ahead of ACK (default 1)\n",
+           FLASH_WINDOW_MAX);
     printf("  -e, --erase                   erase the entire chip\n");
     printf("  -d, --debug                   enable debug output\n");
     printf("  -v, --version                 display version information\n");
+    printf("      --report <file>           append timing of this run to file as JSON line\n");
+    printf("      --handshake-speed <baud>  detect chip at this rate, falling back down to %d\n",
+           MINBAUD);
+    printf("                                (default: family last seen on the adapter)\n");
+    printf("      --downshift               lower the baudrate and resume when the link\n");
+    printf("                                produces errors while writing\n");
+    printf("      --queue-writes            go on once a frame is queued to the port instead\n");
+    printf("                                of waiting until it is sent\n");
+    printf("      --rx-thread               read the port continuously in a separate thread\n");
+    printf("      --chip-db <file>          look chip models up in file first, see make chipdb\n");
+    printf("      --compile <file>          write the -f image with its frames for -b and -e\n");
+    printf("                                to a compiled image, to be flashed with -f\n");
+    printf("      --target <model>          with --compile, only allow flashing this model\n");
+    printf("      --verify-image            check a compiled image against its hash on load\n");
     printf("\n");
     printf("Baudrate options:\n");
     printf("   4800, 9600, 19200, 38400, 57600, 115200, 230400, 460800, 500000, 576000,\n");
@@ -87,31 +229,38 @@ static void version(void)
 
 /***
  * @brief invite MCU to flashing
+ * @param session       - [inout] programming session
  * @param reset_time    - [in] if more then zero, time to pull down
  *                        dtr line for resetting MCU
  * @param reset_cmd     - [in] if not NULL, external command
  *                        for resetting or power cycling MCU
  * @param reset_args    - [in] arguments for reset_cmd
+ * @param resets        - [in] count of dtr reset cycles
+ * @param wait          - [in] detect try count after the reset command
+ *                        or while waiting for a power cycle
  * @param recv          - [out] chip detect data
  *      
  * @return              - 0 if invitation was successfull,
  *                        error code if chip not detected 
  */
-static int32_t invite_mcu(const uint32_t reset_time,
+static int32_t invite_mcu(stc_session_t *session,
+                          const uint32_t reset_time,
 			  char* const reset_cmd,
 			  char* const reset_args[],
+                          const uint8_t resets,
+                          const uint16_t wait,
                           uint8_t* restrict const recv)
 {
     if(0 < reset_time)
     {
-        for(uint8_t sel = RESET_RETRY_COUNT; sel; --sel)
+        for(uint8_t sel = resets; sel; --sel)
         {
             printf("Reset MCU by pulling low dtr for %d milliseconds\n", reset_time);
-            serial.dtr_set(&serial, true);
+            session->port->dtr_set(session->port, true);
             usleep((unsigned int)reset_time * 1000);
-            serial.dtr_set(&serial, false);
+            session->port->dtr_set(session->port, false);
             printf("Waiting for MCU: ");
-            const int detected = chip_detect(recv, CHIP_DETECT_RST_TRYCOUNT);
+            const int detected = chip_detect(session, recv, CHIP_DETECT_RST_TRYCOUNT);
             if(0 == detected)
             {
                 return 0;
@@ -137,110 +286,442 @@ static int32_t invite_mcu(const uint32_t reset_time,
         } else {
             printf("Waiting for MCU, please cycle power: ");
         }
-        const int detected = chip_detect(recv, CHIP_DETECT_WAIT_TRYCOUNT);
+        const int detected = chip_detect(session, recv, wait);
         return detected;
     }
 }
 
+/***
+ * @brief invite MCU, falling back to slower handshake rates on timeout
+ * @param session       - [inout] programming session, port at speed
+ * @param cfg           - [in] programming settings
+ * @param speed         - [in] first handshake rate
+ * @param recv          - [out] chip detect data
+ *      
+ * @return              - 0 if chip was detected, port is left at the
+ *                        rate it answered at, error code otherwise
+ */
+static int32_t detect_mcu(stc_session_t *session, const prog_config_t *cfg,
+                          unsigned int speed, uint8_t* restrict const recv)
+{
+    static const unsigned int ladder[] = {115200, 57600, 38400, 19200, 9600, 4800, MINBAUD};
+    size_t i = 0;
+    int32_t ret;
 
-int main(int argc, char *const argv[])
+    for (;;)
+    {
+        const bool last = (speed <= MINBAUD);
+        if (speed != MINBAUD)
+        {
+            printf("Handshake at %u baud\n", speed);
+        }
+        /* fast rates get one reset cycle or a short power cycle wait,
+         * the minimum all of them */
+        ret = invite_mcu(session, cfg->reset_time, cfg->reset_cmd, cfg->reset_args,
+                         last ? RESET_RETRY_COUNT : 1,
+                         last || cfg->reset_cmd ? CHIP_DETECT_WAIT_TRYCOUNT : CHIP_DETECT_FAST_TRYCOUNT,
+                         recv);
+        if (0 == ret || last)
+        {
+            return ret;
+        }
+        while (ladder[i] >= speed)
+        {
+            i++;
+        }
+        speed = ladder[i];
+        printf("\e[33mno answer\e[0m, falling back to %u baud\n", speed);
+        if (session->port->speed_set(session->port, speed) < 0)
+        {
+            return -EIO;
+        }
+    }
+}
+
+/***
+ * @brief copy a string for a JSON string value, quotes and backslash
+ *        are escaped, control characters become \u00HH
+ * @param dst           - [out] escaped string
+ * @param size          - [in] dst size
+ * @param raw           - [in] string as is
+ */
+static void json_escape(char *dst, size_t size, const char *raw)
 {
-    unsigned long flags = 0;
-    unsigned int speed = DEFAULTS_SPEED;
-    uint32_t reset_time = 0;
-    char *reset_cmd = NULL;
-    char *reset_args[LEN_RESET_ARGS];
-    char *file = NULL;
-    char *port = DEFAULTS_PORT;
-    int ret, hex_size;
-    char arg;
-    const stc_model_t *stc_model;
-    const stc_protocol_t *stc_protocol;
-    uint8_t *recv = (uint8_t [255]){};
-    uint16_t chip_code, chip_version, chip_minor_version, chip_stepping;
-    uint32_t chip_fosc;
+    size_t len = 0;
 
-    /** No buffer, disable buffering on stdout  */
-    setbuf(stdout, NULL);
-    while ((arg = getopt_long(argc, argv, "p:r:s:f:edhv", options, NULL)) != -1) {
-        switch (arg) {
-            case 'p':
-                port = optarg;
-                break;
-            case 's':
-                speed = atoi(optarg);
-                break;
-            case 'r':
-                if (strspn(optarg, "0123456789") == strlen(optarg)) {
-                    reset_time = atoi(optarg);
-                    if ((DTR_RESET_MIN_MILLISECONDS > reset_time) ||
-                        (DTR_RESET_MAX_MILLISECONDS < reset_time)) {
-                        printf("Reset time should be %d < reset_time < %d\n",
-                               DTR_RESET_MIN_MILLISECONDS, DTR_RESET_MAX_MILLISECONDS);
-                        exit(1);
-                    }
-                } else {
-                    int idx = 0;
-                    reset_cmd = reset_args[idx++] = optarg;
-                    while (optind < argc && idx < LEN_RESET_ARGS) {
-                       if (strcmp(argv[optind], ";") == 0) break;
-                       reset_args[idx++] = argv[optind++];
-                    }
-                    if (idx == LEN_RESET_ARGS) {
-                       puts("Reset command has too many arguments.");
-                       exit(1);
-                    }
-                    reset_args[idx] = NULL;
-                }
-                break;
-            case 'f':
-                file = optarg;
-                break;
-            case 'e':
-                flags |= FLAG_ERASE;
-                break;
-            case 'd':
-                flags |= FLAG_DEBUG;
-                break;
-            case 'v':
-                version();
-                break;
-            case 'h': default:
-                usage();
+    for (; *raw; raw++)
+    {
+        const unsigned char c = *raw;
+        const size_t need = (c < 0x20 || 0x7F == c) ? 6 : ('"' == c || '\\' == c) ? 2 : 1;
+        if (len + need >= size)
+        {
+            break;
+        }
+        if (1 == need)
+        {
+            dst[len++] = c;
+        }
+        else if (2 == need)
+        {
+            dst[len++] = '\\';
+            dst[len++] = c;
+        }
+        else
+        {
+            len += snprintf(dst + len, size - len, "\\u%04X", c);
         }
     }
+    dst[len] = '\0';
+}
 
-    if (argc < 2)
-        usage();
+/***
+ * @brief append run summary to the report file, called at exit
+ */
+static void report_write(void)
+{
+    FILE *out;
+    const stc_stats_t *stats = &prog_session.stats;
+    uint64_t total_us = monotonic_us() - report.start_us;
+    char port[PATH_MAX * 2], model[64];
 
-    if (flags & FLAG_DEBUG)
-        set_debug(true);
+    if (!report.path || !(out = fopen(report.path, "a")))
+    {
+        return;
+    }
+    json_escape(port, sizeof(port), report.port ? report.port : "");
+    json_escape(model, sizeof(model), report.model ? report.model : "");
+    fprintf(out, "{\"port\": \"%s\", \"model\": \"%s\", \"speed\": %u, \"size\": %d, "
+                 "\"result\": \"%s\", ",
+            port, model, report.speed, report.size,
+            report.ok ? "ok" : "failed");
+    for (int i = 0; i < PHASE_COUNT; i++)
+    {
+        fprintf(out, "\"%s_ms\": %.3f, ", phase_names[i], report.phase_us[i] / 1000.0);
+    }
+    fprintf(out, "\"total_ms\": %.3f, \"written\": %u, \"blocks\": %u, "
+                 "\"write_bytes_per_sec\": %.0f, \"detect_tries\": %u, \"read_retries\": %u, "
+                 "\"write_retries\": %u, \"resent_blocks\": %u, \"downshifts\": %u, "
+                 "\"reply_latency_us\": %.1f, \"turnaround_avg_us\": %.1f, "
+                 "\"turnaround_max_us\": %llu, \"block_ack_avg_us\": %.1f}\n",
+            total_us / 1000.0, stats->bytes, stats->blocks,
+            report.phase_us[PHASE_WRITE] ? stats->bytes * 1e6 / report.phase_us[PHASE_WRITE] : 0.0,
+            stats->detect_tries, stats->read_retries,
+            stats->write_retries, stats->resent_blocks, stats->downshifts,
+            stats->replies ? (double)stats->reply_us / stats->replies : 0.0,
+            stats->turnarounds ? (double)stats->turnaround_us / stats->turnarounds : 0.0,
+            (unsigned long long)stats->turnaround_max_us,
+            stats->blocks ? (double)stats->ack_us / stats->blocks : 0.0);
+    fclose(out);
+}
+
+/***
+ * @brief read one line sysfs attribute
+ * @param dir           - [in] sysfs directory
+ * @param attr          - [in] attribute name
+ * @param buf           - [out] attribute value without line end
+ * @param size          - [in] buf size
+ * 
+ * @return              - true if attribute was read
+ */
+static bool sysfs_read(const char *dir, const char *attr, char *buf, size_t size)
+{
+    char path[PATH_MAX];
+    FILE *f;
+    bool ok;
+
+    snprintf(path, sizeof(path), "%s/%s", dir, attr);
+    if (!(f = fopen(path, "r")))
+    {
+        return false;
+    }
+    ok = fgets(buf, size, f) != NULL;
+    fclose(f);
+    buf[strcspn(buf, "\r\n")] = '\0';
+    return ok;
+}
 
-    if (file)
+/***
+ * @brief copy an adapter key as a single word of the baud cache,
+ *        whitespace, backslash and control characters become \xHH
+ * @param key           - [out] escaped key
+ * @param size          - [in] key size
+ * @param raw           - [in] key as built
+ */
+static void adapter_key_escape(char *key, size_t size, const char *raw)
+{
+    size_t len = 0;
+
+    for (; *raw; raw++)
     {
-        printf("Loading hex file: ");
-        if ((hex_size = load_hex_file(file)) < 0)
+        const unsigned char c = *raw;
+        const size_t need = (isgraph(c) && '\\' != c) ? 1 : 4;
+        if (len + need >= size)
         {
-            printf("Failed to load hex file\n");
-            exit(1);
+            break;
+        }
+        if (1 == need)
+        {
+            key[len++] = c;
+        }
+        else
+        {
+            len += snprintf(key + len, size - len, "\\x%02X", c);
+        }
+    }
+    key[len] = '\0';
+}
+
+/***
+ * @brief build the baud cache key of the adapter behind port,
+ *        USB vendor, product and serial number where available,
+ *        device path otherwise
+ * @param port          - [in] serial port device path
+ * @param key           - [out] adapter key, escaped to a single word
+ * @param size          - [in] key size
+ */
+static void adapter_key(const char *port, char *key, size_t size)
+{
+    char path[PATH_MAX], dev[PATH_MAX], vid[8], pid[8], serial[64], raw[PATH_MAX];
+    char *name;
+
+    adapter_key_escape(key, size, port);
+#ifdef __linux__
+    if (!realpath(port, path) || !(name = strrchr(path, '/')))
+    {
+        return;
+    }
+    snprintf(dev, sizeof(dev), "/sys/class/tty/%s/device", name + 1);
+    if (!realpath(dev, path))
+    {
+        return;
+    }
+    /* walk up from the tty interface to the USB device */
+    for (int depth = 0; depth < 4 && (name = strrchr(path, '/')) && name != path; depth++)
+    {
+        if (sysfs_read(path, "serial", serial, sizeof(serial))
+            && sysfs_read(path, "idVendor", vid, sizeof(vid))
+            && sysfs_read(path, "idProduct", pid, sizeof(pid)))
+        {
+            snprintf(raw, sizeof(raw), "usb:%s:%s:%s", vid, pid, serial);
+            adapter_key_escape(key, size, raw);
+            return;
         }
+        *name = '\0';
     }
+#endif
+}
+
+/***
+ * @brief locate the baud cache file
+ * @param path          - [out] file path
+ * @param size          - [in] path size
+ * 
+ * @return              - true if a location is known
+ */
+static bool baud_cache_path(char *path, size_t size)
+{
+    const char *dir;
+
+    if ((dir = getenv("STC8PROG_BAUD_CACHE")))
+    {
+        snprintf(path, size, "%s", dir);
+    }
+    else if ((dir = getenv("XDG_CACHE_HOME")))
+    {
+        snprintf(path, size, "%s/" BAUD_CACHE_NAME, dir);
+    }
+    else if ((dir = getenv("HOME")))
+    {
+        snprintf(path, size, "%s/.cache/" BAUD_CACHE_NAME, dir);
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+/***
+ * @brief look up what is known about an adapter
+ * @param key           - [in] adapter key
+ * @param profile       - [out] adapter profile, zeroed if not known
+ */
+static void adapter_profile_load(const char *key, adapter_profile_t *profile)
+{
+    char path[PATH_MAX], line[ADAPTER_KEY_MAX + 32], name[ADAPTER_KEY_MAX + 1];
+    unsigned int speed, protocol, ceiling;
+    FILE *f;
+
+    memset(profile, 0, sizeof(*profile));
+    if (!baud_cache_path(path, sizeof(path)) || !(f = fopen(path, "r")))
+    {
+        return;
+    }
+    while (fgets(line, sizeof(line), f))
+    {
+        protocol = ceiling = 0;
+        if (2 <= sscanf(line, ADAPTER_KEY_SCAN " %u %x %u", name, &speed, &protocol, &ceiling)
+            && 0 == strcmp(name, key))
+        {
+            profile->speed = speed;
+            profile->protocol = protocol;
+            profile->ceiling = ceiling;
+        }
+    }
+    fclose(f);
+}
+
+/***
+ * @brief remember what is known about an adapter,
+ *        the file is locked as gang children update it concurrently
+ * @param key           - [in] adapter key
+ * @param profile       - [in] adapter profile
+ */
+static void adapter_profile_store(const char *key, const adapter_profile_t *profile)
+{
+    char path[PATH_MAX], line[ADAPTER_KEY_MAX + 32], name[ADAPTER_KEY_MAX + 1];
+    char *keep = NULL;
+    size_t keep_len = 0;
+    FILE *f, *mem;
+    int fd;
+
+    if (!baud_cache_path(path, sizeof(path))
+        || (fd = open(path, O_RDWR | O_CREAT, 0644)) < 0)
+    {
+        return;
+    }
+    if (flock(fd, LOCK_EX) < 0 || !(f = fdopen(fd, "r+")))
+    {
+        close(fd);
+        return;
+    }
+    /* keep entries of other adapters */
+    if ((mem = open_memstream(&keep, &keep_len)))
+    {
+        while (fgets(line, sizeof(line), f))
+        {
+            if (1 == sscanf(line, ADAPTER_KEY_SCAN, name) && strcmp(name, key))
+            {
+                fputs(line, mem);
+            }
+        }
+        fprintf(mem, "%s %u %04x %u\n", key, profile->speed, profile->protocol, profile->ceiling);
+        fclose(mem);
+        rewind(f);
+        fwrite(keep, 1, keep_len, f);
+        fflush(f);
+        if (ftruncate(fd, keep_len) < 0)
+        {
+            perror("Could not update baud cache");
+        }
+        free(keep);
+    }
+    fclose(f);
+}
+
+/***
+ * @brief bring the chip back to the handshake after it took a rate the
+ *        adapter can not carry, remembering that rate for the next runs
+ * @param session       - [inout] programming session, port at failed rate
+ * @param recv          - [out] chip detect data
+ * 
+ * @return              - 0 if the chip answered again, error code otherwise
+ */
+static int reinvite_mcu(stc_session_t *session, uint8_t *recv)
+{
+    const prog_config_t *cfg = reinvite_ctx.cfg;
+    adapter_profile_t *profile = reinvite_ctx.profile;
+    const unsigned int failed = session->port->speed;
+    int32_t ret;
+
+    printf("\e[33m%u baud does not carry\e[0m\n", failed);
+    if (0 == profile->ceiling || failed < profile->ceiling)
+    {
+        profile->ceiling = failed;
+        adapter_profile_store(reinvite_ctx.key, profile);
+    }
+    if (session->port->speed_set(session->port, reinvite_ctx.handshake) < 0)
+    {
+        return -EIO;
+    }
+    ret = invite_mcu(session, cfg->reset_time, cfg->reset_cmd, cfg->reset_args,
+                     RESET_RETRY_COUNT, CHIP_DETECT_WAIT_TRYCOUNT, recv);
+    if (0 == ret)
+    {
+        printf("\e[32mdetected\e[0m, negotiating: ");
+    }
+    return ret;
+}
+
+/***
+ * @brief run the whole programming sequence on one port,
+ *        exits with error code on failure
+ * @param cfg           - [in] programming settings
+ * @param port          - [in] serial port device path
+ */
+static void program_port(const prog_config_t *cfg, const char *port)
+{
+    int ret;
+    uint64_t phase_start;
+    stc_session_t *session = &prog_session;
+    userial_t *serial;
+    const stc_model_t *stc_model;
+    const stc_protocol_t *stc_protocol;
+    uint8_t *recv = (uint8_t [255]){};
+    uint16_t chip_code, chip_version, chip_minor_version, chip_stepping;
+    uint32_t chip_fosc;
+    unsigned int handshake;
+    char key[ADAPTER_KEY_MAX + 1];
+    adapter_profile_t profile;
 
     printf("Opening port %s: ", port);
-    if ((ret = serial.ctor(&serial, port)))
+    if (!(serial = userial_alloc()) || (ret = serial->ctor(serial, port)))
     {
         printf("\e[31mcan not open port\e[0m\n");
         exit(1);
     }
     printf("\e[32mdone\e[0m\n");
+    /* if asked for, frames are prepared while the previous one is on the
+     * wire, speed changes wait for the queue themselves */
+    serial->tx_queue = (cfg->flags & FLAG_QUEUE) != 0;
 
-    if ((ret = serial.setup(&serial, MINBAUD, 8, 1, USERIAL_PARITY_EVEN)))
+    stc_session_init(session, serial, compiled.image ? compiled.image : &image);
+    session->frames = compiled.frames.data ? &compiled.frames : &frames;
+    session->block_size = cfg->block_size;
+    session->window = cfg->window;
+    session->downshift = (cfg->flags & FLAG_DOWNSHIFT) != 0;
+    if ((cfg->flags & FLAG_RX_THREAD) && !(session->rx = rx_thread_start(serial)))
     {
-        printf("\e[31mfailed to communicate chip with baudrate %d\e[0m\n", MINBAUD);
+        printf("\e[31mcan not start reader thread\e[0m\n");
         exit(1);
     }
 
-    const int32_t invite_res = invite_mcu(reset_time, reset_cmd, reset_args, recv);
+    adapter_key(port, key, sizeof(key));
+    adapter_profile_load(key, &profile);
+
+    /* handshake rate: option, else with a reset method the default of
+     * the family last seen on this adapter, else the safe minimum, a
+     * power cycled chip would have to be cycled again on a miss */
+    handshake = cfg->handshake_speed;
+    if (0 == handshake && (cfg->reset_time || cfg->reset_cmd) && profile.protocol
+        && (stc_protocol = protocol_lookup(profile.protocol)))
+    {
+        handshake = stc_protocol->handshake_speed;
+    }
+    if (0 == handshake)
+    {
+        handshake = MINBAUD;
+    }
+
+    phase_start = monotonic_us();
+    if ((ret = serial->setup(serial, handshake, 8, 1, USERIAL_PARITY_EVEN)))
+    {
+        printf("\e[31mfailed to communicate chip with baudrate %d\e[0m\n", handshake);
+        exit(1);
+    }
+
+    const int32_t invite_res = detect_mcu(session, cfg, handshake, recv);
+    report.phase_us[PHASE_DETECT] = monotonic_us() - phase_start;
     if(0 == invite_res)
     {
         printf("\e[32mdetected\e[0m\n");
@@ -258,6 +739,8 @@ int main(int argc, char *const argv[])
     if (stc_model)
     {
         printf("MCU type: \e[32m%s\e[0m\n", stc_model->name);
+        report.model = stc_model->name;
+        session->model = stc_model;
     }
     else
     {
@@ -269,12 +752,26 @@ int main(int argc, char *const argv[])
     if (stc_protocol)
     {
         printf("Protocol: \e[32m%s\e[0m\n", stc_protocol->name);
+        /* only -a runs keep the adapter profile up to date */
+        if ((cfg->flags & FLAG_AUTO_BAUD) && stc_protocol->id != profile.protocol)
+        {
+            profile.protocol = stc_protocol->id;
+            adapter_profile_store(key, &profile);
+        }
     }
     else
     {
         printf("Protocol: \e[31munsupported protocol: %04x\e[0m\n", stc_model->protocol);
         exit(1);
     }
+    /** chip the image was compiled for */
+    if (compiled.header && ((compiled.header->magic_code && compiled.header->magic_code != chip_code)
+                            || (compiled.header->protocol && compiled.header->protocol != stc_protocol->id)))
+    {
+        const stc_model_t *target = model_lookup(compiled.header->magic_code);
+        printf("\e[31mimage is compiled for %s\e[0m\n", target ? target->name : "another chip");
+        exit(1);
+    }
 
     /** f/w version */
     chip_version = *(recv + 17);
@@ -284,10 +781,7 @@ int main(int argc, char *const argv[])
         chip_version >> 4, chip_version & 0x0F, chip_minor_version & 0x0F, chip_stepping);
 
     /** chip fosc */
-    chip_fosc = (*(recv + stc_protocol->info_pos_fosc) << 24) 
-            + (*(recv + stc_protocol->info_pos_fosc + 1) << 16) 
-            + (*(recv + stc_protocol->info_pos_fosc + 2) << 8) 
-            + *(recv + stc_protocol->info_pos_fosc + 3);
+    chip_fosc = chip_info_fosc(stc_protocol, recv);
     printf("IRC frequency(Hz): ");
     if (chip_fosc == 0xffffffff)
     {
@@ -297,31 +791,99 @@ int main(int argc, char *const argv[])
     {
         printf("\e[32m%u\e[0m\n", chip_fosc);
     }
-
-    printf("Switching to \e[32m%d\e[0m baud, chip: ", speed);
-    if ((ret = baudrate_set(stc_protocol, speed, recv)))
+    /* baud divisors follow the real clock, default for implausible values */
+    if (chip_fosc >= FOSC_MIN && chip_fosc <= FOSC_MAX)
     {
-        printf("failed\n");
-        exit(1);
-    }
-    else
-    {
-        printf("\e[32mset\e[0m, ");
+        session->fosc = chip_fosc;
     }
-    
-    printf("host: ");
-    if ((ret = serial.speed_set(&serial, speed)) < 0)
+
+    if (cfg->flags & FLAG_AUTO_BAUD)
     {
-        printf("failed\n");
-        exit(1);
+        unsigned int speed = cfg->speed;
+
+        if (profile.speed && profile.speed < speed)
+        {
+            speed = profile.speed;
+        }
+        /* start below what the adapter failed to carry before */
+        if (profile.ceiling && speed >= profile.ceiling && baudrate_next(profile.ceiling))
+        {
+            speed = baudrate_next(profile.ceiling);
+        }
+        reinvite_ctx.cfg = cfg;
+        reinvite_ctx.handshake = serial->speed;
+        reinvite_ctx.key = key;
+        reinvite_ctx.profile = &profile;
+        printf("Negotiating baud from \e[32m%u\e[0m: ", speed);
+        phase_start = monotonic_us();
+        ret = baudrate_negotiate(session, stc_protocol, recv, chip_version,
+                                 speed, AUTO_BAUD_PINGS, reinvite_mcu);
+        report.phase_us[PHASE_BAUD_SWITCH] = monotonic_us() - phase_start;
+        if (ret < 0)
+        {
+            printf("\e[31mno rate works, reset the chip\e[0m\n");
+            exit(1);
+        }
+        printf("\e[32m%d\e[0m baud, ", ret);
+        report.speed = ret;
+        if ((unsigned int)ret != profile.speed)
+        {
+            profile.speed = ret;
+            adapter_profile_store(key, &profile);
+        }
     }
     else
     {
-        printf("\e[32mset\e[0m, ");
+        unsigned int speed = cfg->speed;
+        unsigned int host = baudrate_match(session, stc_protocol, speed);
+        if (0 == host)
+        {
+            /* port can't follow the chip, fall back to a rate both can do */
+            speed = baudrate_plan(stc_protocol, session->fosc, cfg->speed);
+            if (speed)
+            {
+                printf("%d baud is off by more than tolerance at %u Hz, chip would run at %u\n",
+                       cfg->speed, session->fosc, baudrate_actual(stc_protocol, session->fosc, cfg->speed));
+                host = baudrate_match(session, stc_protocol, speed);
+            }
+            if (0 == host)
+            {
+                printf("\e[31m%d baud can not be reached at %u Hz\e[0m\n", cfg->speed, session->fosc);
+                exit(1);
+            }
+        }
+        report.speed = host;
+        printf("Switching to \e[32m%u\e[0m baud, chip: ", host);
+        phase_start = monotonic_us();
+        if ((ret = baudrate_set(session, stc_protocol, speed, recv)))
+        {
+            printf("failed\n");
+            exit(1);
+        }
+        else
+        {
+            printf("\e[32mset\e[0m, ");
+        }
+
+        printf("host: ");
+        if ((ret = serial->speed_set(serial, host)) < 0)
+        {
+            printf("failed\n");
+            exit(1);
+        }
+        else
+        {
+            printf("\e[32mset\e[0m, ");
+        }
+
+        report.phase_us[PHASE_BAUD_SWITCH] = monotonic_us() - phase_start;
     }
 
     printf("ping: ");
-    if ((ret = baudrate_check(stc_protocol, recv, chip_version)) != 0)
+    phase_start = monotonic_us();
+    ret = baudrate_check(session, stc_protocol, recv, chip_version);
+    report.phase_us[PHASE_BAUD_CHECK] = monotonic_us() - phase_start;
+    if (ret != 0)
     {
         printf("failed\n");
         exit(1);
@@ -331,10 +893,13 @@ int main(int argc, char *const argv[])
         printf("\e[32msucc\e[0m\n");
     }
 
-    if (flags & FLAG_ERASE)
+    if (cfg->flags & FLAG_ERASE)
     {
         printf("Erasing chip: ");
-        if ((ret = flash_erase(stc_protocol, recv)) != 0)
+        phase_start = monotonic_us();
+        ret = flash_erase(session, stc_protocol, recv);
+        report.phase_us[PHASE_ERASE] = monotonic_us() - phase_start;
+        if (ret != 0)
         {
             printf("failed\n");
             exit(1);
@@ -345,16 +910,370 @@ int main(int argc, char *const argv[])
         }
     }
 
-    if (file) {
-        printf("Writing flash, size %d: ", hex_size);
-        if ((ret = flash_write(stc_protocol, hex_size)) != 0)
+    if (cfg->file) {
+        printf("Writing flash, size %d: ", cfg->hex_size);
+        phase_start = monotonic_us();
+        ret = flash_write(session, stc_protocol, cfg->hex_size,
+                          (cfg->flags & FLAG_ERASE) != 0);
+        report.phase_us[PHASE_WRITE] = monotonic_us() - phase_start;
+        if (session->stats.downshifts)
+        {
+            report.speed = serial->speed;
+            /* start the next auto-baud run where this one ended */
+            if ((cfg->flags & FLAG_AUTO_BAUD) && serial->speed < profile.speed)
+            {
+                profile.speed = serial->speed;
+                adapter_profile_store(key, &profile);
+            }
+        }
+        if (ret != 0)
         {
             printf("failed\n");
+            exit(1);
         }
         else
         {
             printf("\e[32mdone\e[0m\n");
         }
     }
+    rx_thread_stop(session->rx);
+    session->rx = NULL;
+    report.ok = true;
+}
+
+/***
+ * @brief copy buffered output of a gang child to the real stdout,
+ *        called at exit
+ */
+static void gang_log_flush(void)
+{
+    char buf[4096];
+    ssize_t size;
+
+    fflush(stdout);
+    rewind(gang_log);
+    while ((size = read(fileno(gang_log), buf, sizeof(buf))) > 0)
+    {
+        if (write(gang_stdout, buf, size) != size)
+        {
+            break;
+        }
+    }
+}
+
+/***
+ * @brief program all ports concurrently, one process per port
+ *
+ * Sessions share nothing but the image, but the front end around them
+ * does: program_port() leaves by exit(1) on every error, the report and
+ * the adapter profile are file statics and the output goes to stdout.
+ * A process per port keeps all of that as it is, a failing port ends
+ * its own process only, and the image and the frames built before the
+ * fork are shared copy-on-write.
+ *
+ * @param cfg           - [in] programming settings
+ * @param ports         - [in] serial port device paths
+ * @param count         - [in] count of ports
+ * 
+ * @return              - 0 if all ports succeeded, 1 otherwise
+ */
+static int program_gang(const prog_config_t *cfg, char *const ports[], int count)
+{
+    pid_t pids[GANG_PORTS_MAX];
+    int status, failed = 0;
+
+    printf("Programming %d ports\n", count);
+    for (int i = 0; i < count; i++)
+    {
+        pids[i] = fork();
+        if (pids[i] < 0)
+        {
+            perror("Could not create new process");
+            failed++;
+        }
+        else if (pids[i] == 0)
+        {
+            /* keep the output of each port together, it is printed at exit */
+            if ((gang_log = tmpfile()) && (gang_stdout = dup(STDOUT_FILENO)) >= 0)
+            {
+                dup2(fileno(gang_log), STDOUT_FILENO);
+                atexit(gang_log_flush);
+            }
+            printf("\n==> %s\n", ports[i]);
+            report.port = ports[i];
+            program_port(cfg, ports[i]);
+            exit(0);
+        }
+    }
+    /* reports are written by the children */
+    report.path = NULL;
+
+    for (int i = 0; i < count; i++)
+    {
+        if (pids[i] < 0)
+        {
+            continue;
+        }
+        waitpid(pids[i], &status, 0);
+        pids[i] = (WIFEXITED(status) && 0 == WEXITSTATUS(status)) ? 0 : -1;
+    }
+    printf("\nResults:\n");
+    for (int i = 0; i < count; i++)
+    {
+        if (0 == pids[i])
+        {
+            printf("  %s: \e[32mok\e[0m\n", ports[i]);
+        }
+        else
+        {
+            printf("  %s: \e[31mfailed\e[0m\n", ports[i]);
+            failed++;
+        }
+    }
+    return failed ? 1 : 0;
+}
+
+int main(int argc, char *const argv[])
+{
+    char *reset_args[LEN_RESET_ARGS];
+    char *ports[GANG_PORTS_MAX] = {DEFAULTS_PORT};
+    int port_count = 0, arg;
+    const stc_model_t *target = NULL;
+    prog_config_t cfg = {
+        .speed = DEFAULTS_SPEED,
+        .block_size = FLASH_BLOCK_DEFAULT,
+        .window = 1,
+        .reset_args = reset_args,
+    };
+
+    /** No buffer, disable buffering on stdout  */
+    setbuf(stdout, NULL);
+    while ((arg = getopt_long(argc, argv, "p:r:s:af:b:w:edhv", options, NULL)) != -1) {
+        switch (arg) {
+            case 'p':
+                if (port_count == GANG_PORTS_MAX) {
+                    printf("No more than %d ports are supported\n", GANG_PORTS_MAX);
+                    exit(1);
+                }
+                ports[port_count++] = optarg;
+                break;
+            case 's':
+                cfg.speed = atoi(optarg);
+                cfg.flags |= FLAG_SPEED_SET;
+                break;
+            case 'a':
+                cfg.flags |= FLAG_AUTO_BAUD;
+                break;
+            case 'r':
+                if (strspn(optarg, "0123456789") == strlen(optarg)) {
+                    cfg.reset_time = atoi(optarg);
+                    if ((DTR_RESET_MIN_MILLISECONDS > cfg.reset_time) ||
+                        (DTR_RESET_MAX_MILLISECONDS < cfg.reset_time)) {
+                        printf("Reset time should be %d < reset_time < %d\n",
+                               DTR_RESET_MIN_MILLISECONDS, DTR_RESET_MAX_MILLISECONDS);
+                        exit(1);
+                    }
+                } else {
+                    int idx = 0;
+                    cfg.reset_cmd = reset_args[idx++] = optarg;
+                    while (optind < argc && idx < LEN_RESET_ARGS) {
+                       if (strcmp(argv[optind], ";") == 0) break;
+                       reset_args[idx++] = argv[optind++];
+                    }
+                    if (idx == LEN_RESET_ARGS) {
+                       puts("Reset command has too many arguments.");
+                       exit(1);
+                    }
+                    reset_args[idx] = NULL;
+                }
+                break;
+            case 'f':
+                cfg.file = optarg;
+                break;
+            case 'b':
+                cfg.block_size = atoi(optarg);
+                if (cfg.block_size < 1 || cfg.block_size > FLASH_BLOCK_MAX) {
+                    printf("Block size should be 1 <= block <= %d\n", FLASH_BLOCK_MAX);
+                    exit(1);
+                }
+                break;
+            case 'w':
+                cfg.window = atoi(optarg);
+                if (cfg.window < 1 || cfg.window > FLASH_WINDOW_MAX) {
+                    printf("Window should be 1 <= window <= %d\n", FLASH_WINDOW_MAX);
+                    exit(1);
+                }
+                break;
+            case 'e':
+                cfg.flags |= FLAG_ERASE;
+                break;
+            case 'd':
+                cfg.flags |= FLAG_DEBUG;
+                break;
+            case 'v':
+                version();
+                break;
+            case OPT_REPORT:
+                report.path = optarg;
+                break;
+            case OPT_HANDSHAKE_SPEED:
+                cfg.handshake_speed = atoi(optarg);
+                if (cfg.handshake_speed < MINBAUD) {
+                    printf("Handshake speed should be at least %d\n", MINBAUD);
+                    exit(1);
+                }
+                break;
+            case OPT_DOWNSHIFT:
+                cfg.flags |= FLAG_DOWNSHIFT;
+                break;
+            case OPT_QUEUE_WRITES:
+                cfg.flags |= FLAG_QUEUE;
+                break;
+            case OPT_RX_THREAD:
+                cfg.flags |= FLAG_RX_THREAD;
+                break;
+            case OPT_CHIP_DB:
+                cfg.chip_db = optarg;
+                break;
+            case OPT_COMPILE:
+                cfg.compile = optarg;
+                break;
+            case OPT_TARGET:
+                cfg.target = optarg;
+                break;
+            case OPT_VERIFY_IMAGE:
+                cfg.flags |= FLAG_VERIFY_IMAGE;
+                break;
+            case 'h': default:
+                usage();
+        }
+    }
+
+    if (argc < 2)
+        usage();
+
+    if (cfg.flags & FLAG_DEBUG)
+        set_debug(true);
+
+    if (0 == port_count)
+        port_count = 1;
+
+    if ((cfg.flags & FLAG_AUTO_BAUD) && !(cfg.flags & FLAG_SPEED_SET))
+        cfg.speed = AUTO_BAUD_MAX;
+
+    report.port = ports[0];
+    report.speed = cfg.speed;
+    report.start_us = monotonic_us();
+    atexit(report_write);
+
+    if (cfg.chip_db)
+    {
+        uint64_t load_start = monotonic_us();
+        int32_t models = model_db_load(cfg.chip_db);
+        if (models < 0)
+        {
+            printf("Failed to load chip database %s: %s\n", cfg.chip_db,
+                   models == -1 ? strerror(errno) : "invalid format");
+            exit(1);
+        }
+        printf("Chip database: %d models, loaded in %u us\n", models,
+               (unsigned int)(monotonic_us() - load_start));
+    }
+
+    if (cfg.target && !(target = model_find(cfg.target)))
+    {
+        printf("Unknown chip model %s\n", cfg.target);
+        exit(1);
+    }
+
+    if (cfg.file)
+    {
+        uint64_t load_start = monotonic_us();
+        /* a file carrying the compiled image magic is used as it is
+         * mapped, anything else goes to the Intel HEX loader, which
+         * reports files that can not be read */
+        if (!cfg.compile && image_file_compiled(cfg.file))
+        {
+            cfg.hex_size = load_image_file(&compiled, cfg.file,
+                                           (cfg.flags & FLAG_VERIFY_IMAGE) != 0);
+            if (cfg.hex_size < 0)
+            {
+                printf("Failed to load compiled image %s: %s\n", cfg.file,
+                       cfg.hex_size == -1 ? strerror(errno) :
+                       cfg.hex_size == -4 ? "image or frame data does not match its hash" :
+                                            "damaged or from another build");
+                exit(1);
+            }
+            printf("Loading compiled image: %d bytes, hash %016llx, %u frames, %u us\n",
+                   cfg.hex_size, (unsigned long long)compiled.header->hash,
+                   compiled.frames.count, (unsigned int)(monotonic_us() - load_start));
+        }
+        else
+        {
+            printf("Loading hex file: ");
+            if ((cfg.hex_size = load_hex_file(&image, cfg.file)) < 0)
+            {
+                printf("Failed to load hex file\n");
+                exit(1);
+            }
+        }
+        report.size = cfg.hex_size;
+    }
+
+    if (cfg.file && !compiled.frames.data)
+    {
+        /* the write command is the same in every protocol, flash_write()
+         * frames blocks itself should the detected chip differ */
+        const stc_protocol_t *frame_protocol = target ? protocol_lookup(target->protocol) : NULL;
+        uint64_t build_start = monotonic_us();
+        int frame_count;
+        if ((frame_count = flash_frames_build(&frames, compiled.image ? compiled.image : &image,
+                                              frame_protocol ? frame_protocol
+                                                             : protocol_lookup(PROTOCOL_STC8GH),
+                                              cfg.hex_size, cfg.block_size,
+                                              (cfg.flags & FLAG_ERASE) != 0)) < 0)
+        {
+            printf("Failed to prepare write frames\n");
+            exit(1);
+        }
+        if (cfg.flags & FLAG_DEBUG)
+        {
+            printf("Prepared %d write frames in %u us\n", frame_count,
+                   (unsigned int)(monotonic_us() - build_start));
+        }
+    }
+
+    if (cfg.compile)
+    {
+        int size;
+        if (!cfg.file)
+        {
+            printf("Nothing to compile, give the hex file with -f\n");
+            exit(1);
+        }
+        if (target && target->code_size && (unsigned int)cfg.hex_size > target->code_size)
+        {
+            printf("Image of %d bytes does not fit the %u bytes of %s\n",
+                   cfg.hex_size, target->code_size, target->name);
+            exit(1);
+        }
+        if ((size = save_image_file(cfg.compile, &image, cfg.hex_size, &frames,
+                                    target ? target->magic_code : 0,
+                                    target ? target->protocol : 0)) < 0)
+        {
+            printf("Failed to write %s: %s\n", cfg.compile, strerror(errno));
+            exit(1);
+        }
+        printf("Compiled %s: %d bytes, %u frames of %u bytes%s, for %s\n", cfg.compile, size,
+               frames.count, frames.block_size, frames.skip_erased ? " skipping erased" : "",
+               target ? target->name : "any chip");
+        return 0;
+    }
+
+    if (port_count > 1)
+        return program_gang(&cfg, ports, port_count);
+
+    program_port(&cfg, ports[0]);
     return 0;
 }
+
@@ -0,0 +1,222 @@
+// Copyright 2022 IOsetting <iosetting@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include "rxthread.h"
+
+/* chunks the ring holds, a power of two */
+#define RX_RING_CHUNKS  64
+/* bytes a single read of the port may bring */
+#define RX_CHUNK_SIZE   256
+/* the reader looks for a stop request at least this often */
+#define RX_POLL_MS      20
+/* reader pause while the consumer lags a full ring behind */
+#define RX_FULL_US      1000
+
+/* data of one read of the port */
+typedef struct {
+    uint64_t time_us;           /* arrival, CLOCK_MONOTONIC */
+    uint32_t len;
+    uint8_t data[RX_CHUNK_SIZE];
+} rx_chunk_t;
+
+struct rx_thread {
+    userial_t *port;
+    pthread_t thread;
+    atomic_bool stop;
+    atomic_int error;           /* port error that ended the reader */
+    /* chunks are filled at head by the reader and taken at tail by the
+     * consumer, each index is written by its owner only */
+    atomic_uint head;
+    atomic_uint tail;
+    uint32_t offset;            /* bytes of the tail chunk consumed */
+    /* wakeup of a consumer waiting on an empty ring, the hot path
+     * never touches it */
+    atomic_bool waiting;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    rx_chunk_t ring[RX_RING_CHUNKS];
+};
+
+static uint64_t rx_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/* wake the consumer if it sleeps on an empty ring */
+static void rx_thread_notify(rx_thread_t *rx)
+{
+    if (atomic_load(&rx->waiting))
+    {
+        pthread_mutex_lock(&rx->lock);
+        pthread_cond_signal(&rx->cond);
+        pthread_mutex_unlock(&rx->lock);
+    }
+}
+
+static void *rx_thread_main(void *arg)
+{
+    rx_thread_t *rx = arg;
+    userial_t *port = rx->port;
+    int32_t ret;
+
+    while (!atomic_load_explicit(&rx->stop, memory_order_relaxed))
+    {
+        const unsigned int head = atomic_load_explicit(&rx->head, memory_order_relaxed);
+        if (head - atomic_load_explicit(&rx->tail, memory_order_acquire) == RX_RING_CHUNKS)
+        {
+            usleep(RX_FULL_US);
+            continue;
+        }
+        if ((ret = port->wait_readable(port, RX_POLL_MS)) == 0)
+        {
+            continue;
+        }
+        rx_chunk_t *chunk = &rx->ring[head % RX_RING_CHUNKS];
+        if (ret > 0)
+        {
+            ret = port->read(port, chunk->data, sizeof(chunk->data));
+        }
+        if (ret < 0)
+        {
+            atomic_store(&rx->error, ret);
+            rx_thread_notify(rx);
+            break;
+        }
+        if (ret == 0)
+        {
+            continue;
+        }
+        chunk->time_us = rx_now_us();
+        chunk->len = ret;
+        atomic_store(&rx->head, head + 1);
+        rx_thread_notify(rx);
+    }
+    return NULL;
+}
+
+rx_thread_t *rx_thread_start(userial_t *port)
+{
+    rx_thread_t *rx = calloc(1, sizeof(*rx));
+    if (!rx)
+    {
+        return NULL;
+    }
+    rx->port = port;
+    atomic_init(&rx->stop, false);
+    atomic_init(&rx->error, 0);
+    atomic_init(&rx->head, 0);
+    atomic_init(&rx->tail, 0);
+    atomic_init(&rx->waiting, false);
+    pthread_mutex_init(&rx->lock, NULL);
+    pthread_cond_init(&rx->cond, NULL);
+    if (pthread_create(&rx->thread, NULL, rx_thread_main, rx))
+    {
+        pthread_cond_destroy(&rx->cond);
+        pthread_mutex_destroy(&rx->lock);
+        free(rx);
+        return NULL;
+    }
+    return rx;
+}
+
+void rx_thread_stop(rx_thread_t *rx)
+{
+    if (rx)
+    {
+        atomic_store(&rx->stop, true);
+        pthread_join(rx->thread, NULL);
+        pthread_cond_destroy(&rx->cond);
+        pthread_mutex_destroy(&rx->lock);
+        free(rx);
+    }
+}
+
+int32_t rx_thread_wait(rx_thread_t *rx, uint64_t timeout_us)
+{
+    const unsigned int tail = atomic_load_explicit(&rx->tail, memory_order_relaxed);
+    struct timespec ts;
+    int32_t ret;
+
+    if (atomic_load_explicit(&rx->head, memory_order_acquire) != tail)
+    {
+        return 1;
+    }
+    /* condition variables time out on the wall clock */
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += timeout_us / 1000000;
+    ts.tv_nsec += (timeout_us % 1000000) * 1000;
+    if (ts.tv_nsec >= 1000000000)
+    {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000;
+    }
+
+    pthread_mutex_lock(&rx->lock);
+    atomic_store(&rx->waiting, true);
+    for (;;)
+    {
+        if (atomic_load(&rx->head) != tail)
+        {
+            ret = 1;
+            break;
+        }
+        if ((ret = atomic_load(&rx->error)))
+        {
+            break;
+        }
+        if (pthread_cond_timedwait(&rx->cond, &rx->lock, &ts))
+        {
+            ret = atomic_load(&rx->head) != tail;
+            break;
+        }
+    }
+    atomic_store(&rx->waiting, false);
+    pthread_mutex_unlock(&rx->lock);
+    return ret;
+}
+
+const uint8_t *rx_thread_peek(rx_thread_t *rx, uint32_t *len, uint64_t *time_us)
+{
+    const unsigned int tail = atomic_load_explicit(&rx->tail, memory_order_relaxed);
+    const rx_chunk_t *chunk;
+
+    if (atomic_load_explicit(&rx->head, memory_order_acquire) == tail)
+    {
+        return NULL;
+    }
+    chunk = &rx->ring[tail % RX_RING_CHUNKS];
+    *len = chunk->len - rx->offset;
+    *time_us = chunk->time_us;
+    return chunk->data + rx->offset;
+}
+
+void rx_thread_consume(rx_thread_t *rx, uint32_t len)
+{
+    const unsigned int tail = atomic_load_explicit(&rx->tail, memory_order_relaxed);
+
+    rx->offset += len;
+    if (rx->offset >= rx->ring[tail % RX_RING_CHUNKS].len)
+    {
+        rx->offset = 0;
+        atomic_store_explicit(&rx->tail, tail + 1, memory_order_release);
+    }
+}
@@ -0,0 +1,67 @@
+// Copyright 2022 IOsetting <iosetting@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __RXTHREAD_H__
+#define __RXTHREAD_H__
+
+#include <stdint.h>
+#include "userial.h"
+
+/* reader thread draining one port into a single producer, single
+ * consumer ring of timestamped chunks */
+typedef struct rx_thread rx_thread_t;
+
+/***
+ * @brief start reading a port in the background, the port must not be
+ *        read by anyone else until rx_thread_stop()
+ * @param port          - [in] opened serial port
+ *
+ * @return              - reader instance, NULL on failure
+ */
+extern rx_thread_t *rx_thread_start(userial_t *port);
+
+/***
+ * @brief stop the reader and release it, unread data is lost
+ * @param rx            - [inout] instance returned by rx_thread_start()
+ */
+extern void rx_thread_stop(rx_thread_t *rx);
+
+/***
+ * @brief wait until received data is available
+ * @param rx            - [inout] reader instance
+ * @param timeout_us    - [in] maximum time to wait in microseconds
+ *
+ * @return              - positive if data is ready, 0 on timeout,
+ *                        error code of the port if the reader stopped
+ */
+extern int32_t rx_thread_wait(rx_thread_t *rx, uint64_t timeout_us);
+
+/***
+ * @brief look at the oldest received data without taking it
+ * @param rx            - [inout] reader instance
+ * @param len           - [out] length of the data
+ * @param time_us       - [out] monotonic time the data arrived at
+ *
+ * @return              - data, NULL if nothing is available
+ */
+extern const uint8_t *rx_thread_peek(rx_thread_t *rx, uint32_t *len, uint64_t *time_us);
+
+/***
+ * @brief take data returned by rx_thread_peek()
+ * @param rx            - [inout] reader instance
+ * @param len           - [in] byte count, up to the peeked length
+ */
+extern void rx_thread_consume(rx_thread_t *rx, uint32_t len);
+
+#endif
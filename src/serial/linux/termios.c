@@ -17,13 +17,18 @@
 #include <stdint.h>
 #include <errno.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <stdbool.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <poll.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 #include <termios.h>
 #include <string.h>
+#include <time.h>
 #include "userial.h"
+#include "termios2.h"
 
 #ifdef __GNUC__
 #define likely(x)       __builtin_expect(!!(x), 1)
@@ -48,6 +53,23 @@ typedef struct linux_serial {
 
 #define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
 
+/* most buffers termios_writev() takes at once */
+#define TERMIOS_SEGMENTS_MAX 8
+/* longest sleep between output queue checks of termios_drain() */
+#define TERMIOS_DRAIN_POLL_US 1000
+/* output queue standing still that long before a speed change fails */
+#define TERMIOS_DRAIN_MS 1000
+/* tty output buffer a blocked write may wait to get room in, in bytes */
+#define TERMIOS_TX_BUFFER 4096
+
+/* monotonic time in milliseconds */
+static uint64_t termios_now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
 // macOS' termios.h doesn't have these baudrates defined
 #ifdef __APPLE__
 #define B460800 460800
@@ -128,6 +150,9 @@ int32_t termios_dtor(linux_serial_t * restrict const this)
     return -ENODEV;
 }
 
+int32_t termios_drain(linux_serial_t * restrict const this,
+                      const uint32_t timeout_ms);
+
 /***
  * @brief set speed for serial port
  * @param this   - [inout] serial port instance
@@ -146,6 +171,11 @@ int32_t termios_speed_set(linux_serial_t * restrict const this,
     unsigned int index = 0;
     int retval;
 
+    /* bytes still queued would go out at the new rate, or be flushed */
+    if (unlikely((retval = termios_drain(this, TERMIOS_DRAIN_MS)) < 0))
+    {
+        return retval;
+    }
     if ((retval = tcgetattr(this->linux_specific.ttys, &term)) < 0) 
     {
         return retval;
@@ -155,10 +185,18 @@ int32_t termios_speed_set(linux_serial_t * restrict const this,
     {
         if ((index + 1) == ARRAY_SIZE(termios_speed))
         {
-            return -1;
+            /* not a standard rate, the kernel may still do it exactly */
+            tcflush(this->linux_specific.ttys, TCIOFLUSH);
+            retval = termios2_speed_set(this->linux_specific.ttys, speed);
+            if(likely(0 == retval)){
+                this->generic.speed = speed;
+            }
+            return retval;
         }
     }
 
+    /* standard rates keep the B-codes, as tcsetattr() in termios_setup()
+     * can not carry a BOTHER rate */
     cfsetispeed(&term, termios_speed[index]);
     cfsetospeed(&term, termios_speed[index]);
 
@@ -397,7 +435,9 @@ int32_t termios_write(linux_serial_t * restrict const this,
     }
 
     const int ret = write(this->linux_specific.ttys, src, src_siz);
-    tcdrain(this->linux_specific.ttys);
+    if (!this->generic.tx_queue) {
+        tcdrain(this->linux_specific.ttys);
+    }
     /***
      * todo: seems read flush can cause problems sometimes,
      * need to be checked
@@ -406,9 +446,164 @@ int32_t termios_write(linux_serial_t * restrict const this,
     return ret;
 }
 
+/***
+ * @brief write several buffers to serial port as one transfer
+ * @param this      - [inout] serial port instance
+ * @param segs      - [in] buffers to write, in order
+ * @param count     - [in] buffer count
+ * 
+ * @return          - write data count on success, error code otherwise 
+ */ 
+int32_t termios_writev(linux_serial_t * restrict const this,
+                       const userial_segment_t * restrict const segs,
+                       const uint32_t count)
+{
+    if(unlikely(SERIAL_PORT_INIT_MAGIC != this->generic.initiated)) {
+        return -ENODEV;
+    }
+    if(unlikely(count > TERMIOS_SEGMENTS_MAX)) {
+        return -EINVAL;
+    }
+
+    struct iovec iov[TERMIOS_SEGMENTS_MAX];
+    struct iovec *pos = iov;
+    uint32_t left = count;
+    int32_t total = 0;
+    /* a full buffer empties at line rate, room has to show up within
+     * that time plus the stall allowed for a drain */
+    const uint32_t speed = this->generic.speed ? this->generic.speed : 2400;
+    const uint64_t stall_ms = TERMIOS_DRAIN_MS + (uint64_t)TERMIOS_TX_BUFFER * 11 * 1000 / speed;
+    uint64_t deadline = termios_now_ms() + stall_ms;
+
+    for (uint32_t i = 0; i < count; i++) {
+        iov[i].iov_base = (void *)segs[i].data;
+        iov[i].iov_len = segs[i].size;
+    }
+    /* the tty may take a part of the frame only */
+    while (left) {
+        ssize_t ret = writev(this->linux_specific.ttys, pos, (int)left);
+        if (unlikely(0 > ret)) {
+            if (EINTR == errno) {
+                continue;
+            }
+            if (EAGAIN != errno) {
+                return -errno;
+            }
+            /* the buffer is full, sleep until it takes more */
+            const uint64_t now = termios_now_ms();
+            if (now >= deadline) {
+                return -ETIMEDOUT;
+            }
+            struct pollfd pfd = {
+                .fd = this->linux_specific.ttys,
+                .events = POLLOUT,
+            };
+            int ready;
+            do {
+                ready = poll(&pfd, 1, (int)(deadline - now));
+            } while (unlikely(0 > ready && EINTR == errno));
+            if (unlikely(0 > ready)) {
+                return -errno;
+            }
+            if (unlikely(0 < ready && (pfd.revents & (POLLERR | POLLHUP | POLLNVAL))
+                         && !(pfd.revents & POLLOUT))) {
+                return -EIO;
+            }
+            continue;
+        }
+        deadline = termios_now_ms() + stall_ms;
+        total += ret;
+        while (left && (size_t)ret >= pos->iov_len) {
+            ret -= pos->iov_len;
+            pos++;
+            left--;
+        }
+        if (left) {
+            pos->iov_base = (uint8_t *)pos->iov_base + ret;
+            pos->iov_len -= ret;
+        }
+    }
+    if (!this->generic.tx_queue) {
+        tcdrain(this->linux_specific.ttys);
+    }
+    return total;
+}
+
+/***
+ * @brief wait until everything written has left the serial port
+ * @param this        - [inout] serial port instance
+ * @param timeout_ms  - [in] give up if the output queue does not shrink
+ *                      for this time, in milliseconds
+ * 
+ * @return            - 0 on success, error code otherwise 
+ */ 
+int32_t termios_drain(linux_serial_t * restrict const this,
+                      const uint32_t timeout_ms)
+{
+    if(unlikely(SERIAL_PORT_INIT_MAGIC != this->generic.initiated)) {
+        return -ENODEV;
+    }
+
+    const int ttys = this->linux_specific.ttys;
+    int queued, last = -1;
+    uint64_t deadline = 0;
+
+    /* the queue length shows progress, so a slow rate is no timeout */
+    while (0 == ioctl(ttys, TIOCOUTQ, &queued) && 0 < queued) {
+        const uint64_t now = termios_now_ms();
+        if (queued != last) {
+            last = queued;
+            deadline = now + timeout_ms;
+        } else if (now >= deadline) {
+            return -ETIMEDOUT;
+        }
+        /* about the time the queue takes on the wire, 11 bit frames */
+        const uint64_t wait_us = this->generic.speed ?
+            (uint64_t)queued * 11 * 1000000 / this->generic.speed : TERMIOS_DRAIN_POLL_US;
+        usleep(wait_us > TERMIOS_DRAIN_POLL_US ? TERMIOS_DRAIN_POLL_US : wait_us + 1);
+    }
+    /* the last bytes may still sit in the UART FIFO */
+    return tcdrain(ttys) ? -errno : 0;
+}
+
+/***
+ * @brief wait until data is available for reading from serial port
+ * @param this        - [inout] serial port instance
+ * @param timeout_ms  - [in] maximum time to wait in milliseconds
+ * 
+ * @return            - positive if data is ready, 0 on timeout,
+ *                      error code otherwise 
+ */ 
+int32_t termios_wait_readable(linux_serial_t * restrict const this,
+                              const uint32_t timeout_ms)
+{
+    if(unlikely(SERIAL_PORT_INIT_MAGIC != this->generic.initiated)) {
+        return -ENODEV;
+    }
+
+    struct pollfd pfd = {
+        .fd = this->linux_specific.ttys,
+        .events = POLLIN,
+    };
+
+    int ret;
+    do {
+        ret = poll(&pfd, 1, (int)timeout_ms);
+    } while (unlikely(0 > ret && EINTR == errno));
+
+    if(unlikely(0 > ret)){
+        return -errno;
+    }
+    if(unlikely(0 < ret && (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) 
+                && !(pfd.revents & POLLIN))){
+        return -EIO;
+    }
+    return ret;
+}
+
     /*** serial port instance ***/
 
-linux_serial_t serial = {
+static const linux_serial_t termios_template = {
     /* generic */
     .generic = {
         .ctor = (userial_ctor_t)termios_ctor,  
@@ -420,6 +615,9 @@ linux_serial_t serial = {
         .dtr_set = (userial_dtr_set_t)termios_dtr,
         .read = (userial_read_t) termios_read,
         .write = (userial_write_t)termios_write, 
+        .writev = (userial_writev_t)termios_writev,
+        .drain = (userial_drain_t)termios_drain,
+        .wait_readable = (userial_wait_readable_t)termios_wait_readable,
 
         .initiated = 0,
     },
@@ -428,4 +626,19 @@ linux_serial_t serial = {
     .linux_specific.ttys = 0,  
 };
 
+userial_t *userial_alloc(void)
+{
+    linux_serial_t *port = malloc(sizeof(*port));
+    if (likely(port)) {
+        *port = termios_template;
+    }
+    return (userial_t *)port;
+}
 
+void userial_free(userial_t *port)
+{
+    if (port) {
+        port->dtor(port);
+        free(port);
+    }
+}
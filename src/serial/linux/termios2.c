@@ -0,0 +1,83 @@
+// Copyright 2022 IOsetting <iosetting@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <errno.h>
+#include "termios2.h"
+
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <asm/termbits.h>
+
+int32_t termios2_speed_set(int fd, uint32_t speed)
+{
+    struct termios2 term, prev;
+
+    if (ioctl(fd, TCGETS2, &prev) < 0)
+    {
+        return -errno;
+    }
+    term = prev;
+    term.c_cflag &= ~(CBAUD | (CBAUD << IBSHIFT));
+    term.c_cflag |= BOTHER | (BOTHER << IBSHIFT);
+    term.c_ispeed = speed;
+    term.c_ospeed = speed;
+    if (ioctl(fd, TCSETS2, &term) < 0)
+    {
+        return -errno;
+    }
+    /* drivers may round to what the adapter can do, refuse large misses
+     * and leave the port at the rate it had */
+    if (ioctl(fd, TCGETS2, &term) < 0)
+    {
+        const int32_t ret = -errno;
+        ioctl(fd, TCSETS2, &prev);
+        return ret;
+    }
+    if ((uint64_t)(term.c_ospeed > speed ? term.c_ospeed - speed : speed - term.c_ospeed) * 100
+        > speed)
+    {
+        ioctl(fd, TCSETS2, &prev);
+        return -EINVAL;
+    }
+    return 0;
+}
+
+uint32_t termios2_speed_get(int fd)
+{
+    struct termios2 term;
+
+    if (ioctl(fd, TCGETS2, &term) < 0)
+    {
+        return 0;
+    }
+    return term.c_ospeed;
+}
+
+#else
+
+int32_t termios2_speed_set(int fd, uint32_t speed)
+{
+    (void)fd;
+    (void)speed;
+    return -ENOTSUP;
+}
+
+uint32_t termios2_speed_get(int fd)
+{
+    (void)fd;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,45 @@
+// Copyright 2022 IOsetting <iosetting@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TERMIOS2_H
+#define TERMIOS2_H
+#include <stdint.h>
+
+/*
+ * Arbitrary baud rates through the Linux termios2 interface. It lives
+ * apart from termios.c, as the kernel and libc termios headers can not
+ * be included together.
+ */
+
+/***
+ * @brief set any integer baud rate with TCSETS2 and BOTHER
+ * @param fd        - [in] opened tty
+ * @param speed     - [in] baud rate
+ * 
+ * @return          - 0 on success, negative error code otherwise,
+ *                    -EINVAL if the driver is more than 1% off, the
+ *                    previous rate is kept then,
+ *                    -ENOTSUP where termios2 does not exist
+ */ 
+extern int32_t termios2_speed_set(int fd, uint32_t speed);
+
+/***
+ * @brief read the output baud rate of a tty with TCGETS2
+ * @param fd        - [in] opened tty
+ * 
+ * @return          - baud rate, 0 if it can not be read
+ */ 
+extern uint32_t termios2_speed_get(int fd);
+
+#endif
@@ -15,6 +15,7 @@
 // limitations under the License.
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <stdbool.h>
 #include <windows.h>
 #include <string.h>
@@ -29,6 +30,9 @@
 #define unlikely(x)
 #endif
 
+/* largest transfer com_writev() gathers */
+#define COM_GATHER_MAX 512
+
 /**
  * @struct the serial port of the win32
  * inherited from generic
@@ -388,9 +392,91 @@ int32_t com_write(win32_serial_t * restrict const this,
 	return dwBytesWr;
 }
 
+/***
+ * @brief write several buffers to serial port as one transfer,
+ *        WriteFileGather() is for page aligned file I/O only, so the
+ *        buffers are gathered here
+ * @param this      - [inout] serial port instance
+ * @param segs      - [in] buffers to write, in order
+ * @param count     - [in] buffer count
+ * 
+ * @return          - write data count on success, error code otherwise 
+ */ 
+int32_t com_writev(win32_serial_t * restrict const this,
+                   const userial_segment_t * restrict const segs,
+                   const uint32_t count)
+{
+    uint8_t buf[COM_GATHER_MAX];
+    uint32_t size = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        if(unlikely(size + segs[i].size > sizeof(buf))) {
+            return -EINVAL;
+        }
+        memcpy(buf + size, segs[i].data, segs[i].size);
+        size += segs[i].size;
+    }
+    return com_write(this, buf, size);
+}
+
+/***
+ * @brief wait until everything written has left the serial port,
+ *        writes complete once the driver took the data, so the
+ *        timeout is left to the driver
+ * @param this        - [inout] serial port instance
+ * @param timeout_ms  - [in] unused
+ * 
+ * @return            - 0 on success, error code otherwise 
+ */ 
+int32_t com_drain(win32_serial_t * restrict const this,
+                  const uint32_t timeout_ms)
+{
+    if(unlikely(SERIAL_PORT_INIT_MAGIC != this->generic.initiated)) {
+        return -ENODEV;
+    }
+    (void)timeout_ms;
+    return FlushFileBuffers(this->win32_specific.ttys) ? 0 : -EIO;
+}
+
+/***
+ * @brief wait until data is available for reading from serial port
+ * @param this        - [inout] serial port instance
+ * @param timeout_ms  - [in] maximum time to wait in milliseconds
+ * 
+ * @return            - positive if data is ready, 0 on timeout,
+ *                      error code otherwise 
+ */ 
+int32_t com_wait_readable(win32_serial_t * restrict const this,
+                          const uint32_t timeout_ms)
+{
+    if(unlikely(SERIAL_PORT_INIT_MAGIC != this->generic.initiated)) {
+        return -ENODEV;
+    }
+
+    DWORD flags;
+    COMSTAT comstat;
+    const DWORD start = GetTickCount();
+
+    for(;;){
+        const bool clear_res = ClearCommError(this->win32_specific.ttys,
+                                              &flags,
+                                              &comstat);
+        if(unlikely(!clear_res)){
+            return -EIO;
+        }
+        if(0 < comstat.cbInQue){
+            return 1;
+        }
+        if((GetTickCount() - start) >= timeout_ms){
+            return 0;
+        }
+        Sleep(1);
+    }
+}
+
     /*** serial port instance ***/
 
-win32_serial_t serial = {
+static const win32_serial_t com_template = {
     /* generic */
     .generic = {
         .ctor = (userial_ctor_t)com_ctor,  
@@ -402,6 +488,9 @@ win32_serial_t serial = {
         .dtr_set = (userial_dtr_set_t)com_dtr,
         .read = (userial_read_t)com_read,
         .write = (userial_write_t)com_write, 
+        .writev = (userial_writev_t)com_writev,
+        .drain = (userial_drain_t)com_drain,
+        .wait_readable = (userial_wait_readable_t)com_wait_readable,
 
         .initiated = 0,
     },
@@ -409,4 +498,19 @@ win32_serial_t serial = {
     /* windows-specific */    
 };
 
+userial_t *userial_alloc(void)
+{
+    win32_serial_t *port = malloc(sizeof(*port));
+    if (likely(port)) {
+        *port = com_template;
+    }
+    return (userial_t *)port;
+}
 
+void userial_free(userial_t *port)
+{
+    if (port) {
+        port->dtor(port);
+        free(port);
+    }
+}
@@ -0,0 +1,120 @@
+#!/bin/sh
+# Copyright 2022 IOsetting <iosetting@outlook.com>
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# End-to-end flashing benchmark against stc8sim.
+#
+# Runs the complete stc8prog sequence (detect, baud switch, ping, erase,
+# write) for every speed and image size, and collects the per-phase
+# timing reports into a JSON array. The image the simulated chip stored is
+# compared with the one written, the script fails if any run failed or
+# stored something else. Settings are taken from environment:
+#
+#   BENCH_SPEEDS    host baud rates
+#   BENCH_SIZES     image sizes in KB
+#   BENCH_MODEL     simulated chip magic code
+#   BENCH_LATENCY   simulated write time per block, usec
+#   BENCH_ERASE     simulated erase time, msec
+#   BENCH_ARGS      extra stc8prog arguments
+#   BENCH_OUTPUT    result file
+
+PROG=${PROG:-./stc8prog}
+SIM=${SIM:-./stc8sim}
+BENCH_SPEEDS=${BENCH_SPEEDS:-"4800 9600 19200 38400 57600 115200 230400 460800 500000 576000 921600 1000000 1152000 1500000 2000000 2500000 3000000 3500000 4000000"}
+BENCH_SIZES=${BENCH_SIZES:-"1 4 16 64"}
+BENCH_MODEL=${BENCH_MODEL:-F784}
+BENCH_LATENCY=${BENCH_LATENCY:-1000}
+BENCH_ERASE=${BENCH_ERASE:-200}
+BENCH_OUTPUT=${BENCH_OUTPUT:-bench_output.json}
+
+WORK=$(mktemp -d)
+PORT=$WORK/tty
+trap 'kill $SIM_PID 2>/dev/null; rm -rf "$WORK"' EXIT INT TERM
+# every run starts from an empty adapter cache of its own
+export STC8PROG_BAUD_CACHE="$WORK/baud"
+
+# write an Intel HEX file of $1 KB pseudo-random data to $2
+gen_hex() {
+    awk -v kb="$1" 'BEGIN {
+        srand(kb);
+        size = kb * 1024;
+        for (addr = 0; addr < size; addr += 16) {
+            sum = 16 + int(addr / 256) + addr % 256;
+            line = sprintf(":10%04X00", addr % 65536);
+            for (i = 0; i < 16; i++) {
+                b = int(rand() * 256);
+                sum += b;
+                line = line sprintf("%02X", b);
+            }
+            print line sprintf("%02X", (256 - sum % 256) % 256);
+        }
+        print ":00000001FF";
+    }' > "$2"
+}
+
+# data bytes of Intel HEX file $1 in address order, one per line
+hex_bytes() {
+    awk 'substr($0, 8, 2) == "00" {
+        data = substr($0, 10, length($0) - 11);
+        for (i = 1; i < length(data); i += 2)
+            print tolower(substr(data, i, 2));
+    }' "$1"
+}
+
+# first $2 bytes of binary file $1, one per line
+bin_bytes() {
+    od -A n -v -t x1 -N "$2" "$1" | tr -s ' ' '\n' | grep .
+}
+
+"$SIM" -m "$BENCH_MODEL" -l "$PORT" -t "$BENCH_LATENCY" -E "$BENCH_ERASE" -w \
+    -o "$WORK/out.bin" > "$WORK/sim.log" 2>&1 &
+SIM_PID=$!
+sleep 1
+
+failed=0
+for kb in $BENCH_SIZES; do
+    gen_hex "$kb" "$WORK/$kb.hex"
+    hex_bytes "$WORK/$kb.hex" > "$WORK/$kb.bytes"
+    for speed in $BENCH_SPEEDS; do
+        printf "%6s KB @ %8s baud: " "$kb" "$speed"
+        rm -f "$WORK/out.bin"
+        "$PROG" -p "$PORT" -s "$speed" -e -f "$WORK/$kb.hex" $BENCH_ARGS \
+            --report "$WORK/report.jsonl" > "$WORK/prog.log" 2>&1
+        ret=$?
+        # wait for the simulator to finish the session, store the image
+        # and reopen the port
+        tries=0
+        while [ "$(grep -c 'started$' "$WORK/sim.log")" -gt "$(grep -c ' ms$' "$WORK/sim.log")" ] \
+                && [ $tries -lt 600 ]; do
+            sleep 0.1
+            tries=$((tries + 1))
+        done
+        sleep 0.1
+        if [ $ret -ne 0 ]; then
+            echo "failed"
+            failed=1
+        elif [ ! -f "$WORK/out.bin" ] \
+                || ! bin_bytes "$WORK/out.bin" $((kb * 1024)) | cmp -s - "$WORK/$kb.bytes"; then
+            echo "stored image differs"
+            failed=1
+        else
+            echo "ok"
+        fi
+    done
+done
+
+awk 'BEGIN { print "[" } NR > 1 { print "," } { printf "  %s", $0 } END { print "\n]" }' \
+    "$WORK/report.jsonl" > "$BENCH_OUTPUT"
+echo "Report written to $BENCH_OUTPUT"
+exit $failed
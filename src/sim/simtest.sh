@@ -0,0 +1,109 @@
+#!/bin/sh
+# Copyright 2022 IOsetting <iosetting@outlook.com>
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Regression runs of stc8prog against stc8sim.
+#
+# Every case erases and writes a small image to a freshly started
+# simulator and compares what the simulated chip stored with the image.
+# Cases are lines of: name, simulator arguments, stc8prog arguments.
+
+PROG=${PROG:-./stc8prog}
+SIM=${SIM:-./stc8sim}
+
+WORK=$(mktemp -d)
+PORT=$WORK/tty
+trap 'kill $SIM_PID 2>/dev/null; rm -rf "$WORK"' EXIT INT TERM
+# keep the adapter cache of the user out of it
+export STC8PROG_BAUD_CACHE="$WORK/baud"
+
+CASES='
+default|-m F784|
+model without total_flash|-m F785 -E 300|
+slow erase of 64 KB|-m F784 -E 1500|
+auto baud, adapter limit|-m F784 -L 1500000|-a -s 4000000
+'
+
+# write an Intel HEX file of $1 KB pseudo-random data to $2
+gen_hex() {
+    awk -v kb="$1" 'BEGIN {
+        srand(kb);
+        size = kb * 1024;
+        for (addr = 0; addr < size; addr += 16) {
+            sum = 16 + int(addr / 256) + addr % 256;
+            line = sprintf(":10%04X00", addr % 65536);
+            for (i = 0; i < 16; i++) {
+                b = int(rand() * 256);
+                sum += b;
+                line = line sprintf("%02X", b);
+            }
+            print line sprintf("%02X", (256 - sum % 256) % 256);
+        }
+        print ":00000001FF";
+    }' > "$2"
+}
+
+# data bytes of Intel HEX file $1 in address order, one per line
+hex_bytes() {
+    awk 'substr($0, 8, 2) == "00" {
+        data = substr($0, 10, length($0) - 11);
+        for (i = 1; i < length(data); i += 2)
+            print tolower(substr(data, i, 2));
+    }' "$1"
+}
+
+# first $2 bytes of binary file $1, one per line
+bin_bytes() {
+    od -A n -v -t x1 -N "$2" "$1" | tr -s ' ' '\n' | grep .
+}
+
+gen_hex 4 "$WORK/image.hex"
+hex_bytes "$WORK/image.hex" > "$WORK/image.bytes"
+size=$(wc -l < "$WORK/image.bytes")
+
+failed=0
+while IFS='|' read -r name sim_args prog_args; do
+    [ -n "$name" ] || continue
+    printf "%-28s " "$name:"
+    rm -f "$WORK/out.bin"
+    "$SIM" -l "$PORT" -o "$WORK/out.bin" $sim_args > "$WORK/sim.log" 2>&1 &
+    SIM_PID=$!
+    sleep 0.5
+    if ! "$PROG" -p "$PORT" -e -f "$WORK/image.hex" $prog_args > "$WORK/prog.log" 2>&1; then
+        echo "failed"
+        tr '\b' '\n' < "$WORK/prog.log" | grep -v '^ *[0-9.]*%$' | tail -n 3
+        failed=1
+    else
+        # the image is stored when the simulator ends the session
+        tries=0
+        while [ "$(grep -c 'started$' "$WORK/sim.log")" -gt "$(grep -c ' ms$' "$WORK/sim.log")" ] \
+                && [ $tries -lt 50 ]; do
+            sleep 0.1
+            tries=$((tries + 1))
+        done
+        if [ -f "$WORK/out.bin" ] \
+                && bin_bytes "$WORK/out.bin" "$size" | cmp -s - "$WORK/image.bytes"; then
+            echo "ok"
+        else
+            echo "stored image differs"
+            failed=1
+        fi
+    fi
+    kill $SIM_PID 2>/dev/null
+    wait $SIM_PID 2>/dev/null
+done <<EOF
+$CASES
+EOF
+
+exit $failed
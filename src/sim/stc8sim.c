@@ -0,0 +1,658 @@
+// Copyright 2022 IOsetting <iosetting@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***
+ * STC ISP bootloader simulator.
+ *
+ * Opens a pseudo-terminal and answers on it like an STC MCU in ISP mode,
+ * so stc8prog can be exercised without hardware:
+ *
+ *   ./stc8sim -l /tmp/ttySTC -o image.bin &
+ *   ./stc8prog -p /tmp/ttySTC -e -f foo.hex
+ */
+
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+
+#include "stc8db.h"
+#include "termios2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <getopt.h>
+#include <poll.h>
+#include <signal.h>
+#include <termios.h>
+#include <time.h>
+
+#define DEFAULTS_MODEL      0xF784      /* STC8H8K64U */
+#define DEFAULTS_FOSC       24000000UL
+#define DEFAULTS_VERSION    0x73
+
+/* host frame: 46 B9 6A 00 LEN payload SUMH SUML 16 */
+#define FRAME_MAX           255
+/* a 0x7F arriving after this much silence starts a new session */
+#define SESSION_IDLE_MS     300
+/* rate mismatch between host and chip UART that garbles frames, permille */
+#define BAUD_MISMATCH_MAX   50
+/* size of the info packet answered to the handshake */
+#define INFO_SIZE           48
+
+typedef enum {
+    SIM_IDLE = 0,       /* waiting for 0x7F handshake */
+    SIM_SESSION,        /* handshake done, parsing command frames */
+} sim_state_t;
+
+typedef struct {
+    /* configuration */
+    const stc_model_t *model;
+    const stc_protocol_t *protocol;
+    uint32_t fosc;
+    uint8_t version;
+    uint32_t write_latency_us;
+    uint32_t erase_latency_ms;
+    bool wire;
+    uint32_t link_max;          /* frames above this host rate may get lost */
+    uint8_t link_loss;          /* loss probability in percent */
+    uint32_t handshake_max;     /* 0x7F sent faster than this is not seen */
+    bool debug;
+    const char *output;
+    const char *link;
+    /* pty */
+    int master;
+    int slave;
+    /* protocol state */
+    sim_state_t state;
+    uint32_t baud;
+    uint8_t frame[FRAME_MAX];
+    uint16_t frame_pos;
+    uint64_t last_rx_ms;
+    uint64_t invite_ms;         /* start of handshakes within a session */
+    /* programmed image */
+    uint8_t image[65536];
+    uint32_t image_end;
+    bool dirty;
+    /* session statistics */
+    uint32_t sessions;
+    uint32_t write_frames;
+    uint32_t write_bytes;
+    uint64_t session_start_ms;
+} sim_t;
+
+static volatile sig_atomic_t quit = 0;
+
+static const struct option options[] = {
+    {"help",        no_argument,        0,  'h'},
+    {"model",       required_argument,  0,  'm'},
+    {"link",        required_argument,  0,  'l'},
+    {"output",      required_argument,  0,  'o'},
+    {"fosc",        required_argument,  0,  'f'},
+    {"fw-version",  required_argument,  0,  'V'},
+    {"latency",     required_argument,  0,  't'},
+    {"erase-time",  required_argument,  0,  'E'},
+    {"wire",        no_argument,        0,  'w'},
+    {"link-limit",  required_argument,  0,  'L'},
+    {"handshake-limit", required_argument, 0, 'H'},
+    {"debug",       no_argument,        0,  'd'},
+    { }, /* NULL */
+};
+
+static void usage(void)
+{
+    printf("Usage: stc8sim [options]...\n");
+    printf("  -h, --help                    display this message\n");
+    printf("  -m, --model <code>            chip magic code in hex (default %04X)\n", DEFAULTS_MODEL);
+    printf("  -l, --link <path>             create symlink to the simulated port\n");
+    printf("  -o, --output <file>           store programmed image to binary file\n");
+    printf("  -f, --fosc <hz>               reported IRC frequency (default %lu)\n", DEFAULTS_FOSC);
+    printf("  -V, --fw-version <hex>        reported firmware version (default %02X)\n", DEFAULTS_VERSION);
+    printf("  -t, --latency <usec>          flash write time per block\n");
+    printf("  -E, --erase-time <msec>       flash erase time\n");
+    printf("  -w, --wire                    emulate transfer time of the serial line\n");
+    printf("  -L, --link-limit <baud>[:<%%>] lose frames sent faster than baud,\n");
+    printf("                                with given probability (default 100%%)\n");
+    printf("  -H, --handshake-limit <baud>  ignore handshake sent faster than baud\n");
+    printf("  -d, --debug                   enable debug output\n");
+    printf("\n");
+    printf("Simulated families:\n");
+    printf("   STC8G/8H, STC8A/8F, STC15B, STC15\n");
+    exit(1);
+}
+
+static uint64_t monotonic_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    quit = 1;
+}
+
+static const struct {
+    speed_t code;
+    uint32_t rate;
+} tty_rates[] = {
+    {B1200, 1200},       {B2400, 2400},       {B4800, 4800},
+    {B9600, 9600},       {B19200, 19200},     {B38400, 38400},
+    {B57600, 57600},     {B115200, 115200},   {B230400, 230400},
+#ifdef B460800
+    {B460800, 460800},   {B500000, 500000},   {B576000, 576000},
+    {B921600, 921600},   {B1000000, 1000000}, {B1152000, 1152000},
+    {B1500000, 1500000}, {B2000000, 2000000}, {B2500000, 2500000},
+    {B3000000, 3000000}, {B3500000, 3500000}, {B4000000, 4000000},
+#endif
+};
+
+/***
+ * @brief read the line speed the host configured on the pty
+ * @param sim   - [in] simulator instance
+ *
+ * @return      - baud rate, 0 if unknown
+ */
+static uint32_t sim_tty_rate(const sim_t *sim)
+{
+    struct termios term;
+    if (tcgetattr(sim->slave, &term) < 0)
+    {
+        return 0;
+    }
+    /* rates set through termios2 don't map to a B-code */
+    const uint32_t rate = termios2_speed_get(sim->slave);
+    if (rate)
+    {
+        return rate;
+    }
+    const speed_t code = cfgetospeed(&term);
+    for (size_t i = 0; i < sizeof(tty_rates) / sizeof(tty_rates[0]); i++)
+    {
+        if (tty_rates[i].code == code)
+        {
+            return tty_rates[i].rate;
+        }
+    }
+    return 0;
+}
+
+/***
+ * @brief wait for the time the bytes spend on the wire, 8E1 framing
+ * @param sim   - [in] simulator instance
+ * @param size  - [in] count of bytes
+ */
+static void sim_wire_delay(const sim_t *sim, uint32_t size)
+{
+    if (sim->wire && sim->baud)
+    {
+        usleep((useconds_t)((uint64_t)size * 11 * 1000000 / sim->baud));
+    }
+}
+
+/***
+ * @brief send response frame to the host
+ * @param sim       - [inout] simulator instance
+ * @param payload   - [in] response payload
+ * @param len       - [in] payload length
+ */
+static void sim_reply(sim_t *sim, const uint8_t *payload, uint8_t len)
+{
+    uint8_t buf[FRAME_MAX + 8], *pt = buf;
+    uint16_t sum = 0x68 + len + 6;
+
+    *pt++ = 0x46;
+    *pt++ = 0xB9;
+    *pt++ = 0x68;
+    *pt++ = 0x00;
+    *pt++ = len + 6;
+    for (uint8_t i = 0; i < len; i++)
+    {
+        sum += payload[i];
+        *pt++ = payload[i];
+    }
+    *pt++ = (uint8_t)(sum >> 8);
+    *pt++ = (uint8_t)sum;
+    *pt++ = 0x16;
+
+    sim_wire_delay(sim, pt - buf);
+    if (write(sim->master, buf, pt - buf) < 0)
+    {
+        perror("stc8sim: write");
+    }
+    if (sim->debug)
+    {
+        fprintf(stderr, "TX:");
+        for (uint8_t *p = buf; p < pt; p++)
+        {
+            fprintf(stderr, " %02X", *p);
+        }
+        fprintf(stderr, "\n");
+    }
+}
+
+/***
+ * @brief store programmed image to the output file
+ * @param sim   - [inout] simulator instance
+ */
+static void sim_save(sim_t *sim)
+{
+    if (!sim->output || !sim->dirty)
+    {
+        return;
+    }
+    FILE *out = fopen(sim->output, "wb");
+    if (!out)
+    {
+        perror("stc8sim: can not open output");
+        return;
+    }
+    fwrite(sim->image, 1, sim->image_end, out);
+    fclose(out);
+    sim->dirty = false;
+}
+
+static void sim_session_end(sim_t *sim)
+{
+    if (sim->state != SIM_SESSION)
+    {
+        return;
+    }
+    fprintf(stderr, "session %u: %u write frames, %u bytes, %llu ms\n",
+            sim->sessions, sim->write_frames, sim->write_bytes,
+            (unsigned long long)(monotonic_ms() - sim->session_start_ms));
+    sim_save(sim);
+    sim->state = SIM_IDLE;
+}
+
+/***
+ * @brief answer the 0x7F handshake with the chip info packet
+ * @param sim   - [inout] simulator instance
+ */
+static void sim_handshake(sim_t *sim)
+{
+    uint8_t info[INFO_SIZE] = {};
+    const uint8_t pos = sim->protocol->info_pos_fosc;
+
+    sim_session_end(sim);
+    sim->baud = sim_tty_rate(sim);
+    sim->sessions++;
+    sim->write_frames = 0;
+    sim->write_bytes = 0;
+    sim->session_start_ms = monotonic_ms();
+    fprintf(stderr, "session %u: started\n", sim->sessions);
+
+    info[0] = 0x50;
+    info[pos] = (uint8_t)(sim->fosc >> 24);
+    info[pos + 1] = (uint8_t)(sim->fosc >> 16);
+    info[pos + 2] = (uint8_t)(sim->fosc >> 8);
+    info[pos + 3] = (uint8_t)sim->fosc;
+    info[17] = sim->version;
+    info[18] = 'T';
+    info[20] = (uint8_t)(sim->model->magic_code >> 8);
+    info[21] = (uint8_t)sim->model->magic_code;
+    info[22] = 0x01;
+    sim_reply(sim, info, sizeof(info));
+    sim->state = SIM_SESSION;
+    sim->frame_pos = 0;
+}
+
+/***
+ * @brief execute one complete command frame
+ * @param sim       - [inout] simulator instance
+ * @param cmd       - [in] command payload
+ * @param len       - [in] payload length
+ */
+static void sim_command(sim_t *sim, const uint8_t *cmd, uint8_t len)
+{
+    const stc_protocol_t *proto = sim->protocol;
+    uint8_t ack[2];
+
+    switch (cmd[0])
+    {
+        case 0x01: /* baud switch, answered at the old speed */
+            if (len >= 5)
+            {
+                const uint32_t reload = 65536 - (((uint32_t)cmd[3] << 8) | cmd[4]);
+                if (reload)
+                {
+                    sim->baud = (proto->id == PROTOCOL_STC15) ?
+                        sim->fosc / reload : sim->fosc / 4 / reload;
+                }
+            }
+            ack[0] = proto->baud_switch[sizeof(proto->baud_switch) - 1];
+            sim_reply(sim, ack, 1);
+            break;
+
+        case 0x05: /* baud check */
+            ack[0] = proto->baud_check[sizeof(proto->baud_check) - 1];
+            sim_reply(sim, ack, 1);
+            break;
+
+        case 0x03: /* erase */
+            usleep(sim->erase_latency_ms * 1000);
+            memset(sim->image, 0xFF, sizeof(sim->image));
+            sim->dirty = true;
+            ack[0] = proto->flash_erase[sizeof(proto->flash_erase) - 1];
+            sim_reply(sim, ack, 1);
+            break;
+
+        case 0x22: /* first write block */
+        case 0x02: /* next write block */
+            if (len >= 5)
+            {
+                const uint32_t addr = ((uint32_t)cmd[1] << 8) | cmd[2];
+                const uint32_t size = len - 5;
+                for (uint32_t i = 0; i < size && addr + i < sizeof(sim->image); i++)
+                {
+                    sim->image[addr + i] = cmd[5 + i];
+                }
+                if (addr + size > sim->image_end)
+                {
+                    sim->image_end = addr + size > sizeof(sim->image) ?
+                        sizeof(sim->image) : addr + size;
+                }
+                sim->dirty = true;
+                sim->write_frames++;
+                sim->write_bytes += size;
+            }
+            usleep(sim->write_latency_us);
+            ack[0] = proto->flash_write[sizeof(proto->flash_write) - 2];
+            ack[1] = proto->flash_write[sizeof(proto->flash_write) - 1];
+            sim_reply(sim, ack, 2);
+            break;
+
+        default:
+            fprintf(stderr, "stc8sim: unknown command %02X\n", cmd[0]);
+            break;
+    }
+}
+
+/***
+ * @brief feed one received byte into the simulator
+ * @param sim   - [inout] simulator instance
+ * @param ch    - [in] received byte
+ */
+static void sim_byte(sim_t *sim, uint8_t ch)
+{
+    static const uint8_t prefix[] = {0x46, 0xB9, 0x6A, 0x00};
+    const uint64_t now = monotonic_ms();
+    bool idle = (now - sim->last_rx_ms) > SESSION_IDLE_MS;
+    sim->last_rx_ms = now;
+
+    /* a host inviting the chip that long has had it reset or power cycled */
+    if (0x7F == ch && 0 == sim->frame_pos)
+    {
+        if (0 == sim->invite_ms)
+        {
+            sim->invite_ms = now;
+        }
+        idle = idle || (now - sim->invite_ms) > SESSION_IDLE_MS;
+    }
+    else
+    {
+        sim->invite_ms = 0;
+    }
+    if (0x7F == ch && 0 == sim->frame_pos && (SIM_IDLE == sim->state || idle))
+    {
+        if (sim->handshake_max && sim_tty_rate(sim) > sim->handshake_max)
+        {
+            return;
+        }
+        sim->invite_ms = 0;
+        sim_handshake(sim);
+        return;
+    }
+    if (SIM_SESSION != sim->state)
+    {
+        return;
+    }
+
+    if (sim->frame_pos < sizeof(prefix))
+    {
+        if (ch == prefix[sim->frame_pos])
+        {
+            sim->frame[sim->frame_pos++] = ch;
+        }
+        else
+        {
+            sim->frame_pos = (ch == prefix[0]) ? 1 : 0;
+        }
+        return;
+    }
+
+    sim->frame[sim->frame_pos++] = ch;
+    /* length counts from 0x6A up to the suffix */
+    const uint16_t total = sim->frame[4] + 2;
+    if (sim->frame[4] < 7)
+    {
+        sim->frame_pos = 0;
+        return;
+    }
+    if (sim->frame_pos < total)
+    {
+        return;
+    }
+    sim->frame_pos = 0;
+
+    uint16_t sum = 0;
+    for (uint16_t i = 2; i < total - 3; i++)
+    {
+        sum += sim->frame[i];
+    }
+    if (sim->frame[total - 1] != 0x16
+        || sim->frame[total - 3] != (uint8_t)(sum >> 8)
+        || sim->frame[total - 2] != (uint8_t)sum)
+    {
+        fprintf(stderr, "stc8sim: frame checksum error\n");
+        return;
+    }
+    const uint32_t rate = sim_tty_rate(sim);
+    if (sim->link_max && rate > sim->link_max
+        && (uint32_t)(rand() % 100) < sim->link_loss)
+    {
+        if (sim->debug)
+        {
+            fprintf(stderr, "stc8sim: frame lost at %u baud\n", rate);
+        }
+        return;
+    }
+    /* chip UART set from a divisor too far off the host rate */
+    if (rate && sim->baud
+        && (uint64_t)(rate > sim->baud ? rate - sim->baud : sim->baud - rate) * 1000
+            > (uint64_t)rate * BAUD_MISMATCH_MAX)
+    {
+        fprintf(stderr, "stc8sim: frame garbled, host %u baud, chip %u baud\n", rate, sim->baud);
+        return;
+    }
+    sim_wire_delay(sim, total);
+    sim_command(sim, sim->frame + 5, (uint8_t)(total - 8));
+}
+
+/***
+ * @brief open new pseudo-terminal and point the link to it
+ * @param sim   - [inout] simulator instance
+ *
+ * @return      - 0 on success, error code otherwise
+ */
+static int sim_pty_open(sim_t *sim)
+{
+    struct termios term;
+
+    sim->master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (sim->master < 0 || grantpt(sim->master) < 0 || unlockpt(sim->master) < 0)
+    {
+        perror("stc8sim: can not open pty");
+        return -1;
+    }
+    const char *slave_path = ptsname(sim->master);
+    /* keep slave open, so master does not see hangup while host reopens it */
+    sim->slave = open(slave_path, O_RDWR | O_NOCTTY);
+    if (sim->slave < 0)
+    {
+        perror("stc8sim: can not open pty slave");
+        return -1;
+    }
+    tcgetattr(sim->slave, &term);
+    cfmakeraw(&term);
+    tcsetattr(sim->slave, TCSANOW, &term);
+
+    if (sim->link)
+    {
+        unlink(sim->link);
+        if (symlink(slave_path, sim->link) < 0)
+        {
+            perror("stc8sim: can not create link");
+            return -1;
+        }
+    }
+    else if (sim->sessions)
+    {
+        printf("Port reopened on %s\n", slave_path);
+        fflush(stdout);
+    }
+    return 0;
+}
+
+int main(int argc, char *const argv[])
+{
+    static sim_t sim = {
+        .fosc = DEFAULTS_FOSC,
+        .version = DEFAULTS_VERSION,
+    };
+    uint16_t code = DEFAULTS_MODEL;
+    int arg;
+
+    while ((arg = getopt_long(argc, argv, "hm:l:o:f:V:t:E:wL:H:d", options, NULL)) != -1) {
+        switch (arg) {
+            case 'm':
+                code = (uint16_t)strtoul(optarg, NULL, 16);
+                break;
+            case 'l':
+                sim.link = optarg;
+                break;
+            case 'o':
+                sim.output = optarg;
+                break;
+            case 'f':
+                sim.fosc = strtoul(optarg, NULL, 0);
+                break;
+            case 'V':
+                sim.version = (uint8_t)strtoul(optarg, NULL, 16);
+                break;
+            case 't':
+                sim.write_latency_us = strtoul(optarg, NULL, 0);
+                break;
+            case 'E':
+                sim.erase_latency_ms = strtoul(optarg, NULL, 0);
+                break;
+            case 'w':
+                sim.wire = true;
+                break;
+            case 'H':
+                sim.handshake_max = strtoul(optarg, NULL, 0);
+                break;
+            case 'L':
+            {
+                char *end;
+                sim.link_max = strtoul(optarg, &end, 0);
+                sim.link_loss = (':' == *end) ? (uint8_t)atoi(end + 1) : 100;
+                break;
+            }
+            case 'd':
+                sim.debug = true;
+                break;
+            case 'h': default:
+                usage();
+        }
+    }
+
+    sim.model = model_lookup(code);
+    if (!sim.model || !(sim.protocol = protocol_lookup(sim.model->protocol)))
+    {
+        fprintf(stderr, "stc8sim: model %04X is unknown or unsupported\n", code);
+        return 1;
+    }
+    memset(sim.image, 0xFF, sizeof(sim.image));
+
+    if (sim_pty_open(&sim) < 0)
+    {
+        return 1;
+    }
+
+    struct sigaction sa = { .sa_handler = on_signal };
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    printf("Simulating %s (%s) on %s\n", sim.model->name, sim.protocol->name,
+           sim.link ? sim.link : ptsname(sim.master));
+    fflush(stdout);
+
+    while (!quit)
+    {
+        struct pollfd pfd = { .fd = sim.master, .events = POLLIN };
+        const int ready = poll(&pfd, 1, SESSION_IDLE_MS);
+        if (ready < 0 && errno != EINTR)
+        {
+            perror("stc8sim: poll");
+            break;
+        }
+        if (ready <= 0)
+        {
+            sim_save(&sim);
+            if (SIM_SESSION == sim.state
+                && (monotonic_ms() - sim.last_rx_ms) > SESSION_IDLE_MS)
+            {
+                /* host is gone, next one gets a freshly plugged port */
+                sim_session_end(&sim);
+                close(sim.slave);
+                close(sim.master);
+                if (sim_pty_open(&sim) < 0)
+                {
+                    break;
+                }
+            }
+            continue;
+        }
+
+        uint8_t buf[256];
+        const ssize_t size = read(sim.master, buf, sizeof(buf));
+        if (size < 0 && errno != EINTR && errno != EAGAIN)
+        {
+            perror("stc8sim: read");
+            break;
+        }
+        for (ssize_t i = 0; i < size; i++)
+        {
+            if (sim.debug)
+            {
+                fprintf(stderr, "RX: %02X\n", buf[i]);
+            }
+            sim_byte(&sim, buf[i]);
+        }
+    }
+
+    sim_session_end(&sim);
+    sim_save(&sim);
+    if (sim.link)
+    {
+        unlink(sim.link);
+    }
+    return 0;
+}
@@ -30,7 +30,7 @@
 
 
 typedef struct _model_paras {
-    char name[24];
+    const char *name;
     uint16_t magic_code;
     uint16_t protocol;
     uint32_t total_flash;
@@ -42,13 +42,62 @@ typedef struct _protocol_paras {
     char name[12];
     uint16_t id;
     uint8_t info_pos_fosc;
+    uint32_t handshake_speed;   /* default detect rate, chips autobaud on 0x7F */
     uint8_t baud_switch[9];
     uint8_t baud_check[6];
     uint8_t flash_erase[6];
     uint8_t flash_write[7];
 } stc_protocol_t;
 
+/* external chip database, see model_db_load() and tools/dbgen.c */
+#define MODEL_DB_MAGIC      "STCD"
+#define MODEL_DB_VERSION    1
+#define MODEL_DB_ORDER      0x0102      /* reads 0x0201 on a host of other byte order */
+
+/* file header, followed by the records and the name strings */
+typedef struct {
+    char magic[4];
+    uint16_t version;
+    uint16_t byte_order;
+    uint16_t record_size;
+    uint16_t reserved;
+    uint32_t count;                     /* records, ascending by magic_code */
+    uint32_t names_size;                /* bytes of NUL terminated names */
+} stc_db_header_t;
+
+typedef struct {
+    uint16_t magic_code;
+    uint16_t protocol;
+    uint32_t name;                      /* offset into the names */
+    uint32_t total_flash;
+    uint32_t code_size;
+    uint32_t eeprom_size;
+} stc_db_record_t;
+
 const stc_model_t* model_lookup(uint16_t code);
 const stc_protocol_t* protocol_lookup(uint16_t id);
 
+/***
+ * @brief find a model by name, ignoring case, the chip database first
+ * @param name          - [in] model name
+ *
+ * @return              - model, NULL if there is none of that name
+ */
+const stc_model_t* model_find(const char *name);
+
+/***
+ * @brief map a chip database file, its models take precedence over the
+ *        built-in ones until model_db_unload(), a previous one is unloaded
+ * @param path          - [in] file written by dbgen
+ *
+ * @return              - number of models, -1 if the file can not be
+ *                        mapped, -2 if it is not a valid database
+ */
+int32_t model_db_load(const char *path);
+
+/***
+ * @brief unmap the chip database, models it returned become invalid
+ */
+void model_db_unload(void);
+
 #endif
\ No newline at end of file
@@ -17,10 +17,63 @@
 #include <stdlib.h>
 #include <ctype.h>
 #include <string.h>
+#include <stddef.h>
+#include <errno.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #define BUF_SIZE 255
 
+/* chip_read() gives up if nothing arrives within this time */
+#define CHIP_READ_IDLE_MS   10
+/* adapter latency allowed between the bytes of a started frame, on top
+ * of the wire time of the longest one */
+#define CHIP_READ_GAP_MS    20
+
+/* standard rates tried by baudrate_negotiate(), fastest first */
+static const unsigned int baud_ladder[] = {
+    4000000, 3500000, 3000000, 2500000, 2000000, 1500000, 1152000, 1000000,
+    921600, 576000, 500000, 460800, 230400, 115200, 57600, 38400, 19200, 9600,
+    4800,
+};
+/* largest chip rate error accepted, in permille, an 11 bit 8E1 frame
+ * stays readable up to about 5% total mismatch */
+#define BAUD_ERROR_MAX      45
+/* attempts to get a baud switch through a lossy line */
+#define BAUD_SWITCH_TRIES   3
+/* blocks between drain points of a pipelined write */
+#define FLASH_CHECK_BLOCKS  16
+/* retransmissions from one drain point before giving up */
+#define FLASH_RETRIES_MAX   3
+/* retransmission rounds within that many sent blocks lowering the rate */
+#define DOWNSHIFT_ERRORS    3
+#define DOWNSHIFT_BLOCKS    64
+/* pings the lower rate has to pass */
+#define DOWNSHIFT_PINGS     4
+/* replies are immediate while negotiating, don't wait long for lost ones */
+#define NEGOTIATE_MARGIN_MS 20
+
+/* host and adapter latency allowed on top of wire and chip time */
+#define REPLY_MARGIN_MS     50
+/* payload of the longest reply expected to a command */
+#define REPLY_PAYLOAD_MAX   32
+/* chip UART and adapter settling after a baud switch, at least */
+#define BAUD_SETTLE_US      1000
+/* write command bytes ahead of the block data */
+#define FLASH_WRITE_HEAD    5
+/* flash timing from the datasheets, with a factor two of margin */
+#define FLASH_SECTOR_SIZE           512
+#define FLASH_ERASE_US_PER_SECTOR   12000
+#define FLASH_WRITE_US_PER_BYTE     15
+/* writes shorter than this report no transfer rate */
+#define FLASH_RATE_MIN_US           10000
+/* erase replies are never given up on sooner than this, the fixed wait
+ * of 255 polls 10 ms apart the erase always had */
+#define FLASH_ERASE_WAIT_MIN_MS     2550
+
 /* disable printing dots due detect sequence,
  * can be useful on slow terminals
  */
@@ -30,22 +83,88 @@ const uint8_t tx_detect[] = {0x7f};
 const uint8_t tx_prefix[] = {0x46, 0xb9, 0x6a, 0x00};
 const uint8_t tx_suffix[] = {0x16};
 const uint8_t rx_prefix[] = {0x46, 0xb9, 0x68, 0x00};
-uint8_t debug = 0, memory[65536];
+static uint8_t debug = 0;
+
+static uint16_t frame_sum(const uint8_t *cmd, uint8_t cmd_len,
+                          const uint8_t *data, uint8_t data_len);
+static uint32_t frame_put(uint8_t *dst, const uint8_t *cmd, uint8_t cmd_len,
+                          const uint8_t *data, uint8_t data_len);
+static int32_t frame_send_segs(stc_session_t *session, const userial_segment_t *segs,
+                               uint32_t count);
+static int32_t frame_send_sum(stc_session_t *session, const uint8_t *cmd, uint8_t cmd_len,
+                              const uint8_t *data, uint8_t data_len, uint16_t sum);
+static int chip_reply(stc_session_t *session, uint8_t *recv, uint64_t timeout_us);
 
 void set_debug(uint8_t val)
 {
     debug = val;
 }
 
+void stc_session_init(stc_session_t *session, userial_t *port, const stc_image_t *image)
+{
+    memset(session, 0, sizeof(*session));
+    session->port = port;
+    session->image = image;
+    session->debug = debug;
+    session->block_size = FLASH_BLOCK_DEFAULT;
+    session->window = 1;
+    session->read_idle_ms = CHIP_READ_IDLE_MS;
+    session->read_gap_ms = CHIP_READ_GAP_MS;
+    session->fosc = FUSER;
+    session->reply_margin_ms = REPLY_MARGIN_MS;
+}
+
+uint64_t monotonic_ms(void)
+{
+    return monotonic_us() / 1000;
+}
+
+uint64_t monotonic_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/***
+ * @brief time a frame spends on the wire at the current rate
+ * @param session       - [in] programming session
+ * @param payload       - [in] frame payload length
+ * 
+ * @return              - transfer time in usec
+ */ 
+static uint64_t frame_time_us(const stc_session_t *session, unsigned int payload)
+{
+    /* 8E1, start, data, parity and stop bit */
+    return (uint64_t)(payload + FRAME_OVERHEAD) * 11 * 1000000 / session->port->speed;
+}
+
+/***
+ * @brief time to wait for the reply to a command
+ * @param session       - [in] programming session
+ * @param cmd_len       - [in] command payload length
+ * @param busy_us       - [in] time the chip spends executing the command
+ * 
+ * @return              - timeout in usec
+ */ 
+static uint64_t reply_timeout_us(const stc_session_t *session, unsigned int cmd_len,
+                                 uint64_t busy_us)
+{
+    return frame_time_us(session, cmd_len) + frame_time_us(session, REPLY_PAYLOAD_MAX)
+           + busy_us + session->reply_margin_ms * 1000ULL;
+}
+
 /***
  * @brief detect chip
+ * @param session       - [inout] programming session
  * @param recv          - [out] chip detect data destination
  * @param retry_count   - [in] handshake retry count
  * 
  * @return              - 0 if chip detected,
  *                        error code otherwise
  */ 
-int32_t chip_detect(uint8_t * restrict const recv,
+int32_t chip_detect(stc_session_t *session,
+                    uint8_t * restrict const recv,
                     const uint16_t retry_count)
 {
     uint16_t count;
@@ -53,14 +172,16 @@ int32_t chip_detect(uint8_t * restrict const recv,
 
     for (count = 0; retry_count > count; ++count) 
     {
-        serial.write(&serial, tx_detect, sizeof(tx_detect));
-        if ((ret = chip_read(recv)) <= 0) {
+        session->port->write(session->port, tx_detect, sizeof(tx_detect));
+        session->stats.detect_tries++;
+        if ((ret = chip_read(session, recv)) <= 0) {
 #ifndef SILENT_DETECT
             if (count & 0x1FF == 0) printf("\n");
             if (count & 0x0F == 0) printf(".");
 #endif
             continue;
         } else if (*recv == 0x50) {
+            memcpy(session->info, recv, sizeof(session->info));
             return 0;
         } else {
 #ifndef SILENT_DETECT
@@ -75,385 +196,1137 @@ int32_t chip_detect(uint8_t * restrict const recv,
     return -1;
 }
 
-int baudrate_set(const stc_protocol_t * stc_protocol, unsigned int speed, uint8_t *recv)
+uint32_t chip_info_fosc(const stc_protocol_t * stc_protocol, const uint8_t *recv)
+{
+    const uint8_t *pos = recv + stc_protocol->info_pos_fosc;
+    return ((uint32_t)pos[0] << 24) + ((uint32_t)pos[1] << 16) + ((uint32_t)pos[2] << 8) + pos[3];
+}
+
+/***
+ * @brief clock ticks per bit of the chip UART, rounded to nearest
+ * @param stc_protocol  - [in] chip protocol
+ * @param fosc          - [in] chip clock
+ * @param speed         - [in] baud rate
+ * 
+ * @return              - reload count, 0 if speed can not be reached
+ */ 
+static unsigned int baudrate_divisor(const stc_protocol_t * stc_protocol,
+                                     uint32_t fosc, unsigned int speed)
+{
+    /* STC15 runs the baud timer in 1T mode, the others divide by 4 */
+    const uint32_t clock = (stc_protocol->id == PROTOCOL_STC15) ? fosc : fosc / 4;
+    const uint32_t div = (clock + speed / 2) / speed;
+    return (div > 0xFFFF) ? 0 : div;
+}
+
+unsigned int baudrate_actual(const stc_protocol_t * stc_protocol,
+                             uint32_t fosc, unsigned int speed)
+{
+    const unsigned int div = baudrate_divisor(stc_protocol, fosc, speed);
+    if (div == 0)
+    {
+        return 0;
+    }
+    return ((stc_protocol->id == PROTOCOL_STC15) ? fosc : fosc / 4) / div;
+}
+
+int baudrate_set(stc_session_t *session, const stc_protocol_t * stc_protocol, unsigned int speed, uint8_t *recv)
 {
-    unsigned int count, ret;
+    unsigned int count;
+    int ret;
     uint8_t arg_size = sizeof(stc_protocol->baud_switch) - 1;
     uint8_t arg[BUF_SIZE] = {};
+    const unsigned int div = baudrate_divisor(stc_protocol, session->fosc, speed);
+    if (div == 0)
+    {
+        printf("baudrate_set %u baud out of range\n", speed);
+        return -1;
+    }
     memcpy(arg, stc_protocol->baud_switch, arg_size);
     arg[1] = *(recv + 4);
+    count = 65536 - div;
+    arg[3] = (count >> 8) & 0xFF;
+    arg[4] = count & 0xFF;
     if (stc_protocol->id == PROTOCOL_STC15)
     {
-        count = 65536 - FUSER / speed;
-        arg[3] = (count >> 8) & 0xFF;
-        arg[4] = count & 0xFF;
-        count = 65536 - FUSER / speed / 2 * 3;
+        count = 65536 - div / 2 * 3;
         arg[5] = (count >> 8) & 0xFF;
         arg[6] = count & 0xFF;
     }
+
+    if ((ret = chip_write(session, arg, arg_size)) < 0)
+    {
+        printf("write to port failed: %s\n", strerror(-ret));
+        return -1;
+    }
+
+    /* the reply comes at the rate the chip is switching from */
+    if ((ret = chip_reply(session, recv, reply_timeout_us(session, arg_size, 0))) <= 0)
+    {
+        return 1;
+    }
+    else if (*recv == stc_protocol->baud_switch[arg_size])
+    {
+        return 0;
+    }
     else
     {
-        count = 65536 - FUSER / 4 / speed;
-        arg[3] = (count >> 8) & 0xFF;
-        arg[4] = count & 0xFF;
+        printf("baudrate_set read unmatched\n");
+        return -1;
     }
+}
 
-    chip_write(arg, arg_size);
+/***
+ * @brief check if chip UART can run at given rate close enough
+ * @param stc_protocol  - [in] chip protocol
+ * @param fosc          - [in] chip clock
+ * @param speed         - [in] baud rate
+ * 
+ * @return              - true if the reload value hits speed within
+ *                        BAUD_ERROR_MAX permille
+ */ 
+static bool baudrate_usable(const stc_protocol_t * stc_protocol, uint32_t fosc, unsigned int speed)
+{
+    const unsigned int actual = baudrate_actual(stc_protocol, fosc, speed);
+    const unsigned int diff = actual > speed ? actual - speed : speed - actual;
+    return actual && (uint64_t)diff * 1000 <= (uint64_t)speed * BAUD_ERROR_MAX;
+}
 
-    for (count = 0; count < 0xFF; ++count)
+unsigned int baudrate_plan(const stc_protocol_t * stc_protocol, uint32_t fosc,
+                           unsigned int max_speed)
+{
+    if (baudrate_usable(stc_protocol, fosc, max_speed))
     {
-        if ((ret = chip_read(recv)) <= 0)
-        {
-            continue;
-        }
-        else if (*recv == stc_protocol->baud_switch[arg_size])
-        {
-            return 0;
-        }
-        else
+        return max_speed;
+    }
+    for (size_t i = 0; i < sizeof(baud_ladder) / sizeof(baud_ladder[0]); i++)
+    {
+        if (baud_ladder[i] < max_speed && baudrate_usable(stc_protocol, fosc, baud_ladder[i]))
         {
-            printf("baudrate_set read unmatched\n");
-            return -1;
+            return baud_ladder[i];
         }
     }
-    return 1;
+    return 0;
 }
 
-int flash_write(const stc_protocol_t * stc_protocol, unsigned int len)
+unsigned int baudrate_match(stc_session_t *session, const stc_protocol_t * stc_protocol,
+                           unsigned int speed)
 {
-    uint8_t *recv = (uint8_t [BUF_SIZE]){}, arg[BUF_SIZE] = {};
-    uint8_t cnt, count, arg_size = sizeof(stc_protocol->flash_write) - 2;
-    unsigned int addr, offset;
-    int ret;
-    memcpy(arg, stc_protocol->flash_write, arg_size);
-    addr = 0;
-    offset = 5;
+    userial_t *port = session->port;
+    const unsigned int current = port->speed;
+    const unsigned int actual = baudrate_actual(stc_protocol, session->fosc, speed);
+    unsigned int host = 0;
 
-    printf("%6.2f%%", 0.0);
-    while (addr < len)
+    if (actual == 0)
+    {
+        return 0;
+    }
+    /* ports taking any rate follow the chip exactly */
+    if (port->speed_set(port, actual) >= 0)
+    {
+        host = actual;
+    }
+    else if (baudrate_usable(stc_protocol, session->fosc, speed)
+             && port->speed_set(port, speed) >= 0)
     {
-        arg[1] = HIBYTE(addr);
-        arg[2] = LOBYTE(addr);
+        host = speed;
+    }
+    port->speed_set(port, current);
+    return host;
+}
 
-        cnt = 0;
-        while (addr < len)
-        {
-            arg[cnt + offset] = *(memory + addr);
-            addr++;
-            cnt++;
-            if (cnt >= 128)
-                break;
-        }
-        chip_write(arg, cnt + offset);
+unsigned int baudrate_next(unsigned int speed)
+{
+    size_t i = 0;
+
+    while (i < sizeof(baud_ladder) / sizeof(baud_ladder[0])
+           && (uint64_t)baud_ladder[i] * 1000 >= (uint64_t)speed * (1000 - BAUD_ERROR_MAX))
+    {
+        i++;
+    }
+    return i < sizeof(baud_ladder) / sizeof(baud_ladder[0]) ? baud_ladder[i] : 0;
+}
+
+int baudrate_negotiate(stc_session_t *session, const stc_protocol_t * stc_protocol,
+                       uint8_t *recv, uint8_t chip_version,
+                       unsigned int max_speed, unsigned int pings,
+                       stc_reinvite_t reinvite)
+{
+    userial_t *port = session->port;
+    const uint32_t reply_margin_ms = session->reply_margin_ms;
+    unsigned int speed = max_speed, host, tried = 0, tries, n;
+    uint8_t info[BUF_SIZE];
+    size_t i = 0;
+    int ret = -1;
 
-        for (count = 0; count < 10; ++count)
+    /* baudrate_set() takes its argument from the detect reply */
+    memcpy(info, recv, BUF_SIZE);
+    session->reply_margin_ms = NEGOTIATE_MARGIN_MS;
+    for (;;)
+    {
+        /* skip rates the host port can not follow before the chip is
+         * touched, and ladder rates leading to the same divisor */
+        host = baudrate_match(session, stc_protocol, speed);
+        if (host && host != tried
+            && (uint64_t)host * 1000 <= (uint64_t)max_speed * (1000 + BAUD_ERROR_MAX))
         {
-            if ((ret = chip_read(recv)) <= 0)
-            {
-                DEBUG_PRINTF("read nothing\n");
-                continue;
-            }
-            else if (*recv == stc_protocol->flash_write[arg_size] 
-                && *(recv + 1) == stc_protocol->flash_write[arg_size + 1])
+            tried = host;
+            DEBUG_PRINTF("trying %u baud, host %u\n", speed, host);
+            /* the switch is sent at the rate the chip is at, which may be
+             * the one that just failed, so give it a few chances */
+            for (tries = 0; tries < BAUD_SWITCH_TRIES; tries++)
             {
-                printf("\b\b\b\b\b\b\b%6.2f%%", addr * 100.0 / len);
-                arg[0] = 0x02;
-                break;
+                memcpy(recv, info, BUF_SIZE);
+                if (0 == baudrate_set(session, stc_protocol, speed, recv))
+                {
+                    break;
+                }
             }
-            else
+            if (tries < BAUD_SWITCH_TRIES)
             {
-                printf("flash_write read unmatched\n");
-                return -1;
+                port->speed_set(port, host);
+                for (n = 0; n < pings; n++)
+                {
+                    if (baudrate_check(session, stc_protocol, recv, chip_version))
+                    {
+                        break;
+                    }
+                }
+                if (n == pings)
+                {
+                    ret = host;
+                    break;
+                }
+                /* the chip is at a rate the line does not carry, further
+                 * switches would go out against it */
+                if (reinvite)
+                {
+                    session->reply_margin_ms = reply_margin_ms;
+                    if (reinvite(session, recv))
+                    {
+                        break;
+                    }
+                    session->reply_margin_ms = NEGOTIATE_MARGIN_MS;
+                    memcpy(info, recv, BUF_SIZE);
+                }
             }
         }
-        fflush(stdout);
+        while (i < sizeof(baud_ladder) / sizeof(baud_ladder[0]) && baud_ladder[i] >= speed)
+        {
+            i++;
+        }
+        if (i == sizeof(baud_ladder) / sizeof(baud_ladder[0]))
+        {
+            break;
+        }
+        speed = baud_ladder[i];
     }
-    printf(" ");
-    return 0;
+    session->reply_margin_ms = reply_margin_ms;
+    return ret;
 }
 
-int flash_erase(const stc_protocol_t * stc_protocol, uint8_t *recv)
+/***
+ * @brief build the write command header for one flash block,
+ *        the block data follows it straight from the image
+ * @param stc_protocol  - [in] chip protocol
+ * @param dst           - [out] command header destination
+ * @param addr          - [in] block start address
+ * @param first         - [in] true for the first block of the session
+ * 
+ * @return              - command header length
+ */ 
+static uint8_t flash_write_cmd(const stc_protocol_t * stc_protocol, uint8_t *dst,
+                               unsigned int addr, bool first)
 {
-    int ret;
-    uint8_t count, arg_size = sizeof(stc_protocol->flash_erase) - 1;
-    uint8_t arg[BUF_SIZE] = {};
-    memcpy(arg, stc_protocol->flash_erase, arg_size);
-    chip_write(arg, arg_size);
-    for (count = 0; count < 0xFF; ++count)
+    memcpy(dst, stc_protocol->flash_write, FLASH_WRITE_HEAD);
+    if (!first)
     {
-        if ((ret = chip_read(recv)) <= 0)
-        {
-            continue;
-        }
-        else if (*recv == stc_protocol->flash_erase[arg_size])
+        dst[0] = 0x02;
+    }
+    dst[1] = HIBYTE(addr);
+    dst[2] = LOBYTE(addr);
+    return FLASH_WRITE_HEAD;
+}
+
+/***
+ * @brief check if block has to be transferred to the chip
+ * @param image         - [in] image to be written
+ * @param addr          - [in] block start address
+ * @param end           - [in] block end address, exclusive
+ * @param skip_erased   - [in] if true, block in erased state is not needed
+ * 
+ * @return              - true if block has to be written
+ */ 
+static bool flash_block_needed(const stc_image_t *image, unsigned int addr, unsigned int end, bool skip_erased)
+{
+    if (!skip_erased)
+    {
+        return true;
+    }
+    for (unsigned int i = 0; i < image->extent_count; i++)
+    {
+        unsigned int from = image->extents[i].start > addr ? image->extents[i].start : addr;
+        unsigned int to = image->extents[i].end < end ? image->extents[i].end : end;
+        for (; from < to; from++)
         {
-            return 0;
+            if (image->memory[from] != 0xFF)
+            {
+                return true;
+            }
         }
-        else
+    }
+    return false;
+}
+
+/***
+ * @brief find next block to be written
+ * @param image         - [in] image to be written
+ * @param addr          - [in] address to start search from, block aligned
+ * @param len           - [in] image length
+ * @param block_size    - [in] block size
+ * @param skip_erased   - [in] if true, blocks in erased state are skipped
+ * 
+ * @return              - block address, len if there are no more blocks
+ */ 
+static unsigned int flash_block_next(const stc_image_t *image, unsigned int addr, unsigned int len,
+                                     unsigned int block_size, bool skip_erased)
+{
+    for (; addr < len; addr += block_size)
+    {
+        unsigned int end = (len - addr < block_size) ? len : addr + block_size;
+        if (flash_block_needed(image, addr, end, skip_erased))
         {
-            printf("erase_flash read unmatched\n");
-            return -1;
+            break;
         }
     }
-    return 1;
+    return addr < len ? addr : len;
 }
 
-int baudrate_check(const stc_protocol_t * stc_protocol, uint8_t *recv, uint8_t chip_version)
+/***
+ * @brief block size flash_write() uses for a requested one
+ * @param block_size    - [in] requested block size
+ * 
+ * @return              - block_size, the default if it is out of range
+ */ 
+static unsigned int flash_block_size(unsigned int block_size)
 {
-    usleep(10000);
-    int ret;
-    uint8_t count, arg_size = sizeof(stc_protocol->baud_check) - 1;
-    uint8_t arg[BUF_SIZE] = {};
-    memcpy(arg, stc_protocol->baud_check, arg_size);
+    return (block_size < 1 || block_size > FLASH_BLOCK_MAX) ? FLASH_BLOCK_DEFAULT : block_size;
+}
+
+int flash_frames_build(stc_frames_t *frames, const stc_image_t *image,
+                       const stc_protocol_t * stc_protocol, unsigned int len,
+                       unsigned int block_size, bool skip_erased)
+{
+    uint8_t head[FLASH_WRITE_HEAD];
+    unsigned int addr, count = 0, total = 0;
+    uint8_t *dst;
 
-    if (chip_version < 0x72)
+    memset(frames, 0, sizeof(*frames));
+    block_size = flash_block_size(block_size);
+    for (addr = flash_block_next(image, 0, len, block_size, skip_erased); addr < len;
+         addr = flash_block_next(image, addr + block_size, len, block_size, skip_erased))
     {
-        chip_write(arg, 1);
+        count++;
+        total += (len - addr < block_size) ? len - addr : block_size;
     }
-    else
+    /* one frame per block, and block 0 once more as the first command */
+    frames->frames = malloc((count + 1) * sizeof(*frames->frames));
+    frames->data = malloc((count + 1) * (FLASH_WRITE_HEAD + FRAME_OVERHEAD) + total + block_size);
+    if (!frames->frames || !frames->data)
     {
-        chip_write(arg, arg_size);
+        flash_frames_free(frames);
+        return -1;
     }
 
-    for (count = 0; count < 0xFF; ++count) 
+    dst = frames->data;
+    for (addr = flash_block_next(image, 0, len, block_size, skip_erased); addr < len;
+         addr = flash_block_next(image, addr + block_size, len, block_size, skip_erased))
     {
-        if ((ret = chip_read(recv)) <= 0)
-        {
-            continue;
-        }
-        else if (*recv == stc_protocol->baud_check[arg_size])
-        {
-            return 0;
-        }
-        else
-        {
-            printf("baudrate_check read unmatched\n");
-            return -1;
-        }
+        stc_frame_t *frame = &frames->frames[frames->count++];
+        frame->offset = dst - frames->data;
+        frame->addr = addr;
+        frame->len = (len - addr < block_size) ? len - addr : block_size;
+        flash_write_cmd(stc_protocol, head, addr, false);
+        dst += frame_put(dst, head, FLASH_WRITE_HEAD, image->memory + addr, frame->len);
     }
-    return 1;
+    if (count)
+    {
+        frames->first = dst - frames->data;
+        addr = frames->frames[0].addr;
+        flash_write_cmd(stc_protocol, head, addr, true);
+        dst += frame_put(dst, head, FLASH_WRITE_HEAD, image->memory + addr, frames->frames[0].len);
+    }
+    frames->total = total;
+    memcpy(frames->flash_write, stc_protocol->flash_write, sizeof(frames->flash_write));
+    frames->len = len;
+    frames->block_size = block_size;
+    frames->skip_erased = skip_erased;
+    return count;
 }
 
-int chip_write(uint8_t *buff, uint8_t len)
+void flash_frames_free(stc_frames_t *frames)
 {
-    uint16_t sum;
-    uint8_t i, *tx_buf = (uint8_t [BUF_SIZE]){}, *tx_pt = tx_buf;
-    memcpy(tx_pt, tx_prefix, sizeof(tx_prefix));
-    tx_pt += sizeof(tx_prefix);
-    *tx_pt++ = len + 6;
-    sum = len + 6 + 0x6a;
-    for (i = 0; i < len; i++)
+    free(frames->data);
+    free(frames->frames);
+    memset(frames, 0, sizeof(*frames));
+}
+
+/***
+ * @brief check if prepared frames fit a write
+ * @param frames        - [in] prepared frames, may be NULL
+ * @param stc_protocol  - [in] chip protocol
+ * @param len           - [in] image length
+ * @param block_size    - [in] block size, as used
+ * @param skip_erased   - [in] if true, blocks in erased state are skipped
+ * 
+ * @return              - true if the frames can be sent as they are
+ */ 
+static bool flash_frames_usable(const stc_frames_t *frames, const stc_protocol_t * stc_protocol,
+                                unsigned int len, unsigned int block_size, bool skip_erased)
+{
+    return frames && frames->data && frames->len == len && frames->block_size == block_size
+           && frames->skip_erased == skip_erased
+           && !memcmp(frames->flash_write, stc_protocol->flash_write, sizeof(frames->flash_write));
+}
+
+/***
+ * @brief wait until the line is quiet and drop whatever arrived,
+ *        so late replies are not taken for replies to a retransmission
+ * @param session       - [inout] programming session
+ */ 
+static void flash_write_flush(stc_session_t *session)
+{
+    uint8_t *recv = (uint8_t [BUF_SIZE]){};
+    while (chip_read(session, recv) > 0)
     {
-        sum += *(buff + i);
-        *tx_pt++ = *(buff + i);
     }
-    *tx_pt++ = HIBYTE(sum);
-    *tx_pt++ = LOBYTE(sum);
-    memcpy(tx_pt, tx_suffix, sizeof(tx_suffix));
-    tx_pt += sizeof(tx_suffix);
-    serial.write(&serial, tx_buf, tx_pt - tx_buf);
-    DEBUG_PRINTF("TX: ");
-    for (i = 0; i < tx_pt - tx_buf; i++)
+    frame_decoder_reset(&session->decoder);
+}
+
+/***
+ * @brief switch chip and host to a rate clearly below the current one
+ * @param session       - [inout] programming session
+ * @param stc_protocol  - [in] chip protocol
+ * 
+ * @return              - new host rate,
+ *                        negative if no lower rate works
+ */ 
+static int flash_write_downshift(stc_session_t *session, const stc_protocol_t * stc_protocol)
+{
+    uint8_t *recv = (uint8_t [BUF_SIZE]){};
+    const unsigned int speed = baudrate_next(session->port->speed);
+
+    if (0 == speed)
     {
-        DEBUG_PRINTF("%02X ", *(tx_buf + i));
+        return -1;
     }
-    DEBUG_PRINTF("\n");
-    return 0;
+    memcpy(recv, session->info, sizeof(session->info));
+    /* a reset in the middle of the write would lose the erase */
+    return baudrate_negotiate(session, stc_protocol, recv, session->info[17],
+                              speed, DOWNSHIFT_PINGS, NULL);
 }
 
-/**
- * return flag;
-*/
-uint8_t flag_check(uint8_t ch)
+/* states of the flash write engine */
+typedef enum {
+    WRITE_FILL,         /* prepare frames of the blocks ahead */
+    WRITE_SEND,         /* queue prepared frames the window allows */
+    WRITE_ACK,          /* wait for the oldest ACK */
+    WRITE_RECOVER,      /* resend from the last drain point or lower the rate */
+    WRITE_DONE,
+    WRITE_FAILED,
+} write_state_t;
+
+/* block prepared or in flight, its data is sent from the image or
+ * as a whole from the prepared frames */
+typedef struct {
+    const uint8_t *frame;   /* prepared frame, NULL if built here */
+    unsigned int frame_len;
+    uint8_t head[FLASH_WRITE_HEAD];
+    unsigned int addr;
+    unsigned int len;
+    uint16_t sum;       /* frame checksum, known before the frame is due */
+    uint64_t sent_us;   /* queued to the port */
+} write_slot_t;
+
+int flash_write(stc_session_t *session, const stc_protocol_t * stc_protocol,
+                unsigned int len, bool skip_erased)
 {
-    static uint8_t rx_flag = 0;
-    static uint16_t rx_sum, rx_index, rx_count;
-    switch (rx_flag)
+    const stc_image_t *image = session->image;
+    const unsigned int block_size = flash_block_size(session->block_size);
+    const stc_frames_t *frames = flash_frames_usable(session->frames, stc_protocol, len,
+                                                     block_size, skip_erased) ? session->frames : NULL;
+    unsigned int window = session->window;
+    /* one slot per in-flight block, plus one prepared for the next ACK */
+    write_slot_t slots[FLASH_WINDOW_MAX + 1], *slot;
+    uint8_t *recv = (uint8_t [BUF_SIZE]){};
+    uint8_t arg_size = sizeof(stc_protocol->flash_write) - 2;
+    unsigned int blocks = 0, total = 0, done = 0, built = 0, sent = 0, acked = 0;
+    unsigned int addr, interval, base_interval, retries = 0, errors = 0, error_sent = 0;
+    /* last point all sent blocks were acknowledged, writing resumes there */
+    unsigned int check_built = 0, check_addr, check_done = 0;
+    /* progress last printed */
+    unsigned int shown = 0;
+    uint64_t start = monotonic_us(), elapsed, timeout, ack_us = 0;
+    write_state_t state = WRITE_FILL;
+    bool progress = false;
+    int ret;
+
+    if (window < 1 || window > FLASH_WINDOW_MAX)
     {
-        case 8:
-            if (ch != 0x16)
-            {
-                DEBUG_PRINTF("end byte unmatched ");
-                rx_flag = 0;
-            }
-            else
-            {
-                rx_flag = 9;
-                DEBUG_PRINTF("end byte reached ");
-            }
-            break;
+        window = 1;
+    }
+    /* ACKs carry no address, a dropped frame only shows as a missing ACK
+     * once the pipeline runs empty, so it is drained at regular points */
+    base_interval = interval = (window == 1) ? 1 : FLASH_CHECK_BLOCKS;
+    if (frames)
+    {
+        blocks = frames->count;
+        total = frames->total;
+        addr = blocks ? frames->frames[0].addr : len;
+    }
+    else
+    {
+        for (addr = flash_block_next(image, 0, len, block_size, skip_erased); addr < len;
+             addr = flash_block_next(image, addr + block_size, len, block_size, skip_erased))
+        {
+            blocks++;
+            total += (len - addr < block_size) ? len - addr : block_size;
+        }
+        addr = flash_block_next(image, 0, len, block_size, skip_erased);
+    }
+    DEBUG_PRINTF("%u blocks, %u of %u bytes to write%s\n", blocks, total, len,
+                 frames ? ", frames prepared" : "");
 
-        case 7:
-            DEBUG_PRINTF("sum check: 0x%02X ", LOBYTE(rx_sum));
-            if (ch != LOBYTE(rx_sum))
-            {
-                DEBUG_PRINTF("low byte of sum unmatched ");
-                rx_flag = 0;
-            }
-            else
+    check_addr = addr;
+    printf("%6.2f%%", 0.0);
+    while (state != WRITE_DONE && state != WRITE_FAILED)
+    {
+        switch (state)
+        {
+        case WRITE_FILL:
+            /* prepared frames may run past a drain point, only sending
+             * stops there */
+            while (built < blocks && built - acked <= window)
             {
-                rx_flag = 8;
+                slot = &slots[built % (window + 1)];
+                if (frames)
+                {
+                    const stc_frame_t *frame = &frames->frames[built];
+                    slot->addr = frame->addr;
+                    slot->len = frame->len;
+                    slot->frame = frames->data + (0 == built ? frames->first : frame->offset);
+                    slot->frame_len = FLASH_WRITE_HEAD + frame->len + FRAME_OVERHEAD;
+                    built++;
+                    addr = (built < blocks) ? frames->frames[built].addr : len;
+                    continue;
+                }
+                slot->frame = NULL;
+                slot->addr = addr;
+                slot->len = (len - addr < block_size) ? len - addr : block_size;
+                flash_write_cmd(stc_protocol, slot->head, addr, 0 == built);
+                slot->sum = frame_sum(slot->head, FLASH_WRITE_HEAD,
+                                      image->memory + addr, slot->len);
+                built++;
+                addr = flash_block_next(image, addr + block_size, len, block_size, skip_erased);
             }
+            state = WRITE_SEND;
             break;
 
-        case 6:
-            DEBUG_PRINTF("sum: 0x%02X ", HIBYTE(rx_sum));
-            if (ch != HIBYTE(rx_sum))
+        case WRITE_SEND:
+            while (sent < built && sent - acked < window && sent < check_built + interval)
             {
-                DEBUG_PRINTF("high byte of sum unmatched ");
-                rx_flag = 0;
+                slot = &slots[sent % (window + 1)];
+                if (slot->frame)
+                {
+                    const userial_segment_t seg = {slot->frame, slot->frame_len};
+                    ret = frame_send_segs(session, &seg, 1);
+                }
+                else
+                {
+                    ret = frame_send_sum(session, slot->head, FLASH_WRITE_HEAD,
+                                         image->memory + slot->addr, slot->len, slot->sum);
+                }
+                /* a port that fails is not a lost ACK, retrying won't help */
+                if (ret < 0)
+                {
+                    printf("\nwrite to port failed: %s\n", strerror(-ret));
+                    state = WRITE_FAILED;
+                    break;
+                }
+                slot->sent_us = session->tx_time_us;
+                sent++;
+                /* host turnaround, from the ACK arriving to the next frame queued */
+                if (ack_us)
+                {
+                    const uint64_t turn = session->tx_time_us - ack_us;
+                    session->stats.turnarounds++;
+                    session->stats.turnaround_us += turn;
+                    if (turn > session->stats.turnaround_max_us)
+                    {
+                        session->stats.turnaround_max_us = turn;
+                    }
+                    ack_us = 0;
+                }
+                /* error rate is taken over the last DOWNSHIFT_BLOCKS sent */
+                if (++error_sent == DOWNSHIFT_BLOCKS)
+                {
+                    errors = error_sent = 0;
+                }
             }
-            else
+            if (state == WRITE_FAILED)
             {
-                rx_flag = 7;
+                break;
             }
-            break;
-
-        case 5:
-            rx_sum += ch;
-            rx_index++;
-            DEBUG_PRINTF("sum:%04X, index:%d, count:%d ", rx_sum, rx_index, rx_count);
-            if (rx_index == rx_count)
+            /* the terminal is served while the frames are on the wire */
+            if (progress)
             {
-                rx_flag = 6;
+                printf("\b\b\b\b\b\b\b%6.2f%%", done * 100.0 / total);
+                fflush(stdout);
+                shown = done;
+                progress = false;
             }
+            state = (acked == blocks) ? WRITE_DONE : WRITE_ACK;
             break;
 
-        case 4:
-            rx_sum = 0x68 + ch;
-            rx_count = ch - 6;
-            rx_index = 0;
-            rx_flag = 5;
-            DEBUG_PRINTF("sum:%04X, count:%d, index:0 ", rx_sum, rx_count);
-            break;
-
-        case 3:
-            if (ch != rx_prefix[3])
-            {
-                DEBUG_PRINTF("flag 3 unmatch ");
-                rx_flag = 0;
-            }
-            else
+        case WRITE_ACK:
+            /* the oldest ACK may be queued behind every frame in flight */
+            timeout = reply_timeout_us(session, 0, 0) + (sent - acked)
+                      * (frame_time_us(session, block_size + FLASH_WRITE_HEAD)
+                         + block_size * FLASH_WRITE_US_PER_BYTE);
+            if ((ret = chip_reply(session, recv, timeout)) <= 0)
             {
-                rx_flag = 4;
+                DEBUG_PRINTF("read nothing\n");
+                state = WRITE_RECOVER;
+                break;
             }
-            break;
-
-        case 2:
-            if (ch != rx_prefix[2])
+            else if (*recv != stc_protocol->flash_write[arg_size]
+                     || *(recv + 1) != stc_protocol->flash_write[arg_size + 1])
             {
-                DEBUG_PRINTF("flag 2 unmatch ");
-                rx_flag = 0;
+                DEBUG_PRINTF("flash_write read unmatched\n");
+                state = WRITE_RECOVER;
+                break;
             }
-            else
+            slot = &slots[acked % (window + 1)];
+            ack_us = session->rx_time_us;
+            session->stats.ack_us += ack_us - slot->sent_us;
+            done += slot->len;
+            acked++;
+            if (acked == sent && (acked == check_built + interval || acked == blocks))
             {
-                rx_flag = 3;
+                session->stats.bytes += done - check_done;
+                session->stats.blocks += acked - check_built;
+                check_built = acked;
+                check_addr = (acked < built) ? slots[acked % (window + 1)].addr : addr;
+                check_done = done;
+                retries = 0;
+                /* the line recovered, drain less often again */
+                interval = (interval * 2 > base_interval) ? base_interval : interval * 2;
             }
+            progress = true;
+            state = WRITE_FILL;
             break;
 
-        case 1:
-            if (ch != rx_prefix[1])
+        case WRITE_RECOVER:
+            /* rewriting acknowledged blocks is harmless, so resume from
+             * the last drain point with the same addresses and data */
+            retries++;
+            errors++;
+            ack_us = 0;
+            flash_write_flush(session);
+            state = WRITE_FILL;
+            if (session->downshift && (errors >= DOWNSHIFT_ERRORS || retries > FLASH_RETRIES_MAX))
             {
-                DEBUG_PRINTF("flag 1 unmatch");
-                rx_flag = 0;
+                printf("\nlink errors at %u baud, lowering: ", session->port->speed);
+                if ((ret = flash_write_downshift(session, stc_protocol)) < 0)
+                {
+                    printf("no lower rate works\n");
+                    state = WRITE_FAILED;
+                    break;
+                }
+                printf("%d baud\n", ret);
+                session->stats.downshifts++;
+                retries = errors = error_sent = 0;
+                printf("%6.2f%%", check_done * 100.0 / total);
+                shown = check_done;
             }
-            else
+            else if (retries > FLASH_RETRIES_MAX)
             {
-                rx_flag = 2;
+                printf("\nblock at %04X not acknowledged after %u retries\n",
+                       check_addr, FLASH_RETRIES_MAX);
+                state = WRITE_FAILED;
+                break;
             }
+            DEBUG_PRINTF("resending from %04X, %u blocks\n", check_addr, sent - check_built);
+            session->stats.write_retries++;
+            session->stats.resent_blocks += sent - check_built;
+            /* on a lossy line a shorter stretch gets through more likely */
+            interval = (interval + 1) / 2;
+            /* blocks from the drain point on are prepared again */
+            built = sent = acked = check_built;
+            addr = check_addr;
+            done = check_done;
             break;
 
-        case 0:
         default:
-            if (ch == rx_prefix[0])
-            {
-                rx_flag = 1;
-            }
             break;
+        }
+    }
+    if (state == WRITE_FAILED)
+    {
+        return -1;
     }
-    DEBUG_PRINTF("flag:%d\n", rx_flag);
-    if (rx_flag == 0)
+    if (shown != total || 0 == total)
     {
-        // reset all values
-        rx_sum = 0; rx_index = 0; rx_count = 0;
+        printf("\b\b\b\b\b\b\b%6.2f%%", 100.0);
     }
-    else if (rx_flag == 9)
+    elapsed = monotonic_us() - start;
+    if (elapsed < FLASH_RATE_MIN_US)
     {
-        // reset all values
-        rx_flag = 0; rx_sum = 0; rx_index = 0; rx_count = 0;
-        return 9;
+        printf(", n/a bytes/s ");
     }
-    return rx_flag;
+    else
+    {
+        printf(", %u bytes/s ", (unsigned int)(total * 1000000ULL / elapsed));
+    }
+    return 0;
 }
 
-/**
- * Read chip response
- * 1. If nothing is received in 100ms, it will return 0
- * 2. If anything is received and run into flags it will keep trying for 320ms for further response
- * 
-*/
-int chip_read(uint8_t *recv)
+int flash_erase(stc_session_t *session, const stc_protocol_t * stc_protocol, uint8_t *recv)
 {
-    /** rx for each rx read, buf to store whole rx */
-    uint8_t flag, content_flag = 0, tickdown = 0, *rx = (uint8_t [BUF_SIZE]){}, *rx_p;
-    //*buf = (uint8_t [BUF_SIZE]){},  
-    int ret, size = 0;
+    int ret;
+    uint8_t arg_size = sizeof(stc_protocol->flash_erase) - 1;
+    uint8_t arg[BUF_SIZE] = {};
+    /* the whole flash is erased sector by sector, the table leaves
+     * total_flash 0 where it is not known */
+    const uint32_t flash_size = !session->model ? 65536
+                                : session->model->total_flash ? session->model->total_flash
+                                : session->model->code_size ? session->model->code_size
+                                : 65536;
+    const uint64_t busy_us = (uint64_t)(flash_size + FLASH_SECTOR_SIZE - 1) / FLASH_SECTOR_SIZE
+                             * FLASH_ERASE_US_PER_SECTOR;
+    uint64_t timeout_us = reply_timeout_us(session, arg_size, busy_us);
+
+    if (timeout_us < FLASH_ERASE_WAIT_MIN_MS * 1000ULL)
+    {
+        timeout_us = FLASH_ERASE_WAIT_MIN_MS * 1000ULL;
+    }
+    memcpy(arg, stc_protocol->flash_erase, arg_size);
+    if ((ret = chip_write(session, arg, arg_size)) < 0)
+    {
+        printf("write to port failed: %s\n", strerror(-ret));
+        return -1;
+    }
+    if ((ret = chip_reply(session, recv, timeout_us)) <= 0)
+    {
+        return 1;
+    }
+    else if (*recv == stc_protocol->flash_erase[arg_size])
+    {
+        return 0;
+    }
+    else
+    {
+        printf("erase_flash read unmatched\n");
+        return -1;
+    }
+}
+
+int baudrate_check(stc_session_t *session, const stc_protocol_t * stc_protocol, uint8_t *recv, uint8_t chip_version)
+{
+    int ret;
+    uint8_t arg_size = sizeof(stc_protocol->baud_check) - 1;
+    uint8_t arg[BUF_SIZE] = {};
+    memcpy(arg, stc_protocol->baud_check, arg_size);
+
+    /* let the chip and the adapter settle on a rate just switched to */
+    usleep(BAUD_SETTLE_US + 20 * 1000000 / session->port->speed);
+
+    /* old firmware takes the bare command */
+    if ((ret = chip_write(session, arg, chip_version < 0x72 ? 1 : arg_size)) < 0)
+    {
+        printf("write to port failed: %s\n", strerror(-ret));
+        return -1;
+    }
+
+    if ((ret = chip_reply(session, recv, reply_timeout_us(session, arg_size, 0))) <= 0)
+    {
+        return 1;
+    }
+    else if (*recv == stc_protocol->baud_check[arg_size])
+    {
+        return 0;
+    }
+    else
+    {
+        printf("baudrate_check read unmatched\n");
+        return -1;
+    }
+}
+
+uint8_t frame_build(uint8_t *dst, const uint8_t *buff, uint8_t len)
+{
+    uint16_t sum;
+    uint8_t i, *tx_pt = dst;
+    memcpy(tx_pt, tx_prefix, sizeof(tx_prefix));
+    tx_pt += sizeof(tx_prefix);
+    *tx_pt++ = len + 6;
+    sum = len + 6 + 0x6a;
+    for (i = 0; i < len; i++)
+    {
+        sum += *(buff + i);
+        *tx_pt++ = *(buff + i);
+    }
+    *tx_pt++ = HIBYTE(sum);
+    *tx_pt++ = LOBYTE(sum);
+    memcpy(tx_pt, tx_suffix, sizeof(tx_suffix));
+    tx_pt += sizeof(tx_suffix);
+    return tx_pt - dst;
+}
+
+/***
+ * @brief checksum of a frame
+ * @param cmd           - [in] command
+ * @param cmd_len       - [in] command length
+ * @param data          - [in] data following the command, may be NULL
+ * @param data_len      - [in] data length
+ * 
+ * @return              - checksum
+ */ 
+static uint16_t frame_sum(const uint8_t *cmd, uint8_t cmd_len,
+                          const uint8_t *data, uint8_t data_len)
+{
+    uint16_t sum = cmd_len + data_len + 6 + 0x6a;
+    uint8_t i;
 
-    do
+    for (i = 0; i < cmd_len; i++)
     {
-        if ((ret = serial.read(&serial,rx, 255)) > 0)
+        sum += cmd[i];
+    }
+    for (i = 0; i < data_len; i++)
+    {
+        sum += data[i];
+    }
+    return sum;
+}
+
+/***
+ * @brief put a command together into a complete frame
+ * @param dst           - [out] frame destination, cmd_len + data_len + 8 bytes
+ * @param cmd           - [in] command
+ * @param cmd_len       - [in] command length
+ * @param data          - [in] data following the command, may be NULL
+ * @param data_len      - [in] data length
+ * 
+ * @return              - frame length
+ */ 
+static uint32_t frame_put(uint8_t *dst, const uint8_t *cmd, uint8_t cmd_len,
+                          const uint8_t *data, uint8_t data_len)
+{
+    const uint16_t sum = frame_sum(cmd, cmd_len, data, data_len);
+    uint8_t *tx_pt = dst;
+
+    memcpy(tx_pt, tx_prefix, sizeof(tx_prefix));
+    tx_pt += sizeof(tx_prefix);
+    *tx_pt++ = cmd_len + data_len + 6;
+    memcpy(tx_pt, cmd, cmd_len);
+    tx_pt += cmd_len;
+    memcpy(tx_pt, data, data_len);
+    tx_pt += data_len;
+    *tx_pt++ = HIBYTE(sum);
+    *tx_pt++ = LOBYTE(sum);
+    memcpy(tx_pt, tx_suffix, sizeof(tx_suffix));
+    tx_pt += sizeof(tx_suffix);
+    return tx_pt - dst;
+}
+
+/***
+ * @brief send frame parts to the chip with a single port write
+ * @param session       - [inout] programming session
+ * @param segs          - [in] frame parts in order
+ * @param count         - [in] part count
+ * 
+ * @return              - write data count on success, error code otherwise
+ */ 
+static int32_t frame_send_segs(stc_session_t *session, const userial_segment_t *segs,
+                               uint32_t count)
+{
+    if (session->debug)
+    {
+        printf("TX: ");
+        for (uint32_t n = 0; n < count; n++)
         {
-            rx_p = rx;
-            DEBUG_PRINTF("read %d bytes:\n", ret);
-            for (uint8_t i = 0; i < ret; i++)
+            for (uint32_t k = 0; k < segs[n].size; k++)
             {
-                DEBUG_PRINTF("0x%02x | ", *(rx_p + i));
-                // flag check
-                flag = flag_check(*(rx_p + i));
-                if (flag > 0)
-                {
-                    tickdown = 32;
-                    if ((flag == 5 || flag == 6) && content_flag == 1)
-                    {
-                        *(recv + (size++)) = *(rx_p + i);
-                        content_flag = 1;
-                    }
-                    if (flag == 5) content_flag = 1;
-                }
-                else
-                {
-                    // restart buf;
-                    size = 0;
-                    content_flag = 0;
-                }
+                printf("%02X ", segs[n].data[k]);
             }
-            if (flag == 9)
+        }
+        printf("\n");
+    }
+    const int32_t ret = session->port->writev(session->port, segs, count);
+    session->tx_time_us = monotonic_us();
+    return ret;
+}
+
+/***
+ * @brief send a command to the chip, the frame is put together by the
+ *        port from its parts, none of them is copied
+ * @param session       - [inout] programming session
+ * @param cmd           - [in] command
+ * @param cmd_len       - [in] command length
+ * @param data          - [in] data following the command, may be NULL
+ * @param data_len      - [in] data length
+ * @param sum           - [in] checksum from frame_sum()
+ * 
+ * @return              - write data count on success, error code otherwise
+ */ 
+static int32_t frame_send_sum(stc_session_t *session, const uint8_t *cmd, uint8_t cmd_len,
+                              const uint8_t *data, uint8_t data_len, uint16_t sum)
+{
+    uint8_t head[sizeof(tx_prefix) + 1], tail[2 + sizeof(tx_suffix)];
+    const userial_segment_t segs[] = {
+        {head, sizeof(head)}, {cmd, cmd_len}, {data, data_len}, {tail, sizeof(tail)},
+    };
+
+    memcpy(head, tx_prefix, sizeof(tx_prefix));
+    head[sizeof(tx_prefix)] = cmd_len + data_len + 6;
+    tail[0] = HIBYTE(sum);
+    tail[1] = LOBYTE(sum);
+    memcpy(tail + 2, tx_suffix, sizeof(tx_suffix));
+    return frame_send_segs(session, segs, sizeof(segs) / sizeof(segs[0]));
+}
+
+int chip_write(stc_session_t *session, uint8_t *buff, uint8_t len)
+{
+    const int32_t ret = frame_send_sum(session, buff, len, NULL, 0, frame_sum(buff, len, NULL, 0));
+    return ret < 0 ? ret : 0;
+}
+
+void frame_decoder_reset(frame_decoder_t *dec)
+{
+    dec->len = 0;
+}
+
+uint32_t frame_decoder_feed(frame_decoder_t *dec, const uint8_t *src, uint32_t size)
+{
+    const uint32_t space = sizeof(dec->buf) - dec->len;
+    if (size > space)
+    {
+        size = space;
+    }
+    memcpy(dec->buf + dec->len, src, size);
+    dec->len += size;
+    return size;
+}
+
+/* drop count bytes from the head of the decoder buffer */
+static void frame_decoder_drop(frame_decoder_t *dec, uint32_t count)
+{
+    dec->len -= count;
+    memmove(dec->buf, dec->buf + count, dec->len);
+}
+
+int frame_decoder_next(frame_decoder_t *dec, uint8_t *payload)
+{
+    uint8_t *start;
+    uint16_t total, sum, i;
+
+    while (dec->len > 0)
+    {
+        /* resync on the first byte of the prefix */
+        if (!(start = memchr(dec->buf, rx_prefix[0], dec->len)))
+        {
+            dec->len = 0;
+            break;
+        }
+        if (start != dec->buf)
+        {
+            frame_decoder_drop(dec, start - dec->buf);
+        }
+        if (dec->len < sizeof(rx_prefix) + 1)
+        {
+            break;
+        }
+        /* length counts from 0x68 up to the suffix, at least 1 byte of payload */
+        total = dec->buf[sizeof(rx_prefix)] + 2;
+        if (memcmp(dec->buf, rx_prefix, sizeof(rx_prefix)) != 0
+            || total < FRAME_OVERHEAD + 1)
+        {
+            frame_decoder_drop(dec, 1);
+            continue;
+        }
+        if (dec->len < total)
+        {
+            break;
+        }
+
+        sum = 0;
+        for (i = 2; i < total - 3; i++)
+        {
+            sum += dec->buf[i];
+        }
+        if (dec->buf[total - 3] != HIBYTE(sum) || dec->buf[total - 2] != LOBYTE(sum)
+            || dec->buf[total - 1] != tx_suffix[0])
+        {
+            dec->errors++;
+            frame_decoder_drop(dec, 1);
+            continue;
+        }
+
+        total -= FRAME_OVERHEAD;
+        memcpy(payload, dec->buf + sizeof(rx_prefix) + 1, total);
+        frame_decoder_drop(dec, total + FRAME_OVERHEAD);
+        return total;
+    }
+    return 0;
+}
+
+/***
+ * @brief read one chip response frame
+ * @param session       - [inout] programming session
+ * @param recv          - [out] frame payload destination
+ * @param idle_us       - [in] give up if nothing arrives within this time
+ * 
+ * @return              - payload length, 0 if nothing complete arrived
+ */ 
+static int chip_read_wait(stc_session_t *session, uint8_t *recv, uint64_t idle_us)
+{
+    userial_t *port = session->port;
+    uint8_t *rx = (uint8_t [BUF_SIZE]){};
+    const uint8_t *data;
+    uint32_t len;
+    int ret, size;
+    uint64_t deadline = monotonic_us() + idle_us;
+    /* a started frame is complete within its wire time, a stall beyond
+     * that means the rest is lost */
+    const uint64_t gap_us = frame_time_us(session, FRAME_PAYLOAD_MAX)
+                            + session->read_gap_ms * 1000ULL;
+
+    /* a frame may be left over from the previous read */
+    while ((size = frame_decoder_next(&session->decoder, recv)) == 0)
+    {
+        const int64_t remain = (int64_t)(deadline - monotonic_us());
+        if (session->rx)
+        {
+            /* data already taken off the port, no syscall unless waiting */
+            if (remain <= 0 || rx_thread_wait(session->rx, remain) <= 0)
             {
-                /**
-                 * Read completed so return immediately, otherwise baudrate_set() 
-                 * will fail for not being invoked in the short window.
-                */
+                DEBUG_PRINTF(".");
                 break;
             }
+            data = rx_thread_peek(session->rx, &len, &session->rx_time_us);
+            rx_thread_consume(session->rx, frame_decoder_feed(&session->decoder, data, len));
+            deadline = monotonic_us() + gap_us;
+            continue;
         }
-        else
+        /* round up, a short wait must not turn into none */
+        if (remain <= 0 || port->wait_readable(port, (uint32_t)((remain + 999) / 1000)) <= 0)
         {
             DEBUG_PRINTF(".");
+            break;
+        }
+        if ((ret = port->read(port, rx, BUF_SIZE)) > 0)
+        {
+            session->rx_time_us = monotonic_us();
+            frame_decoder_feed(&session->decoder, rx, ret);
+            deadline = monotonic_us() + gap_us;
         }
-        usleep(10000);
-    } while (tickdown-- && size < BUF_SIZE && flag > 0);
-    if (size > 0)
+    }
+    if (size > 0 && session->debug)
     {
+        printf("RX: ");
         for (ret = 0; ret < size; ret++)
         {
-            DEBUG_PRINTF("%02X ", *(recv + ret));
+            printf("%02X ", *(recv + ret));
         }
-        DEBUG_PRINTF("\n");
+        printf("\n");
     }
     
     return size;
 }
 
+/**
+ * Read chip response
+ * 1. If nothing is received in session->read_idle_ms, it will return 0
+ * 2. If anything is received it will keep waiting for the rest of the
+ *    frame until nothing arrives for the wire time of the longest frame
+ *    plus session->read_gap_ms
+ * 
+*/
+int chip_read(stc_session_t *session, uint8_t *recv)
+{
+    return chip_read_wait(session, recv, session->read_idle_ms * 1000ULL);
+}
+
+/***
+ * @brief wait for the reply to a command
+ * @param session       - [inout] programming session
+ * @param recv          - [out] reply payload destination
+ * @param timeout_us    - [in] time the reply is expected within
+ * 
+ * @return              - payload length, 0 on timeout
+ */ 
+static int chip_reply(stc_session_t *session, uint8_t *recv, uint64_t timeout_us)
+{
+    const int ret = chip_read_wait(session, recv, timeout_us);
+    if (ret <= 0)
+    {
+        session->stats.read_retries++;
+    }
+    else if (session->rx_time_us > session->tx_time_us)
+    {
+        session->stats.replies++;
+        session->stats.reply_us += session->rx_time_us - session->tx_time_us;
+    }
+    return ret;
+}
+
+/* hex digit values tagged with 0x10, untagged entries are not hex digits */
+static const uint8_t hex_nibble[256] = {
+	['0'] = 0x10, ['1'] = 0x11, ['2'] = 0x12, ['3'] = 0x13, ['4'] = 0x14,
+	['5'] = 0x15, ['6'] = 0x16, ['7'] = 0x17, ['8'] = 0x18, ['9'] = 0x19,
+	['A'] = 0x1A, ['B'] = 0x1B, ['C'] = 0x1C, ['D'] = 0x1D, ['E'] = 0x1E, ['F'] = 0x1F,
+	['a'] = 0x1A, ['b'] = 0x1B, ['c'] = 0x1C, ['d'] = 0x1D, ['e'] = 0x1E, ['f'] = 0x1F,
+};
+
+/* decodes two hex digits at src, returns -1 if any of them is not a digit */
+static inline int hex_byte(const char *src)
+{
+	const uint8_t hi = hex_nibble[(uint8_t)src[0]];
+	const uint8_t lo = hex_nibble[(uint8_t)src[1]];
+	if (!(hi & lo & 0x10)) return -1;
+	return ((hi & 0x0F) << 4) | (lo & 0x0F);
+}
+
+int hex_record_parse(const char *line, size_t size, uint8_t *bytes,
+                     int *addr, int *num, int *code)
+{
+	int len, b, i;
+	unsigned int sum;
+
+	*num = 0;
+	if (size < 11 || line[0] != ':') return 0;
+	if ((len = hex_byte(line + 1)) < 0) return 0;
+	if (size < (size_t)(11 + len * 2)) return 0;
+	if ((b = hex_byte(line + 3)) < 0) return 0;
+	sum = len + b;
+	*addr = b << 8;
+	if ((b = hex_byte(line + 5)) < 0) return 0;
+	sum += b;
+	*addr |= b;
+	if ((*code = hex_byte(line + 7)) < 0) return 0;
+	sum += *code;
+	line += 9;
+	for (i = 0; i < len; i++, line += 2) {
+		if ((b = hex_byte(line)) < 0) return 0;
+		bytes[i] = b;
+		sum += b;
+	}
+	if ((b = hex_byte(line)) < 0) return 0;
+	if ((sum + b) & 255) return 0; /* checksum error */
+	*num = len;
+	return 1;
+}
+
 /* parses a line of intel hex code, stores the data in bytes[] */
 /* and the beginning address in addr, and returns a 1 if the */
 /* line was valid, or a 0 if an error occured.  The variable */
@@ -461,76 +1334,81 @@ int chip_read(uint8_t *recv)
 
 int parse_hex_line(char *theline, int bytes[], int *addr, int *num, int *code)
 {
-	int sum, len, cksum;
-	char *ptr;
-	
-	*num = 0;
-	if (theline[0] != ':') return 0;
-	if (strlen(theline) < 11) return 0;
-	ptr = theline+1;
-	if (!sscanf(ptr, "%02x", &len)) return 0;
-	ptr += 2;
-	if ( strlen(theline) < (size_t)(11 + (len * 2)) ) return 0;
-	if (!sscanf(ptr, "%04x", addr)) return 0;
-	ptr += 4;
-	  /* printf("Line: length=%d Addr=%d\n", len, *addr); */
-	if (!sscanf(ptr, "%02x", code)) return 0;
-	ptr += 2;
-	sum = (len & 255) + ((*addr >> 8) & 255) + (*addr & 255) + (*code & 255);
-	while(*num != len) {
-		if (!sscanf(ptr, "%02x", &bytes[*num])) return 0;
-		ptr += 2;
-		sum += bytes[*num] & 255;
-		(*num)++;
-		if (*num >= 256) return 0;
-	}
-	if (!sscanf(ptr, "%02x", &cksum)) return 0;
-	if ( ((sum & 255) + (cksum & 255)) & 255 ) return 0; /* checksum error */
+	uint8_t data[255];
+	int i;
+
+	if (!hex_record_parse(theline, strlen(theline), data, addr, num, code)) return 0;
+	for (i = 0; i < *num; i++) bytes[i] = data[i];
 	return 1;
 }
 
-/* loads an intel hex file into the global memory[] array */
-/* filename is a string of the file to be opened */
-int load_hex_file(char *filename)
+/* records the address range [start, end) as holding image data */
+static void hex_extent_add(stc_image_t *image, unsigned int start, unsigned int end)
 {
-	char line[1000];
-	FILE *fin;
-	int addr, n, status, bytes[256];
-	int i, total=0, lineno=1;
-	int minaddr=65536, maxaddr=0;
-
-	if (strlen(filename) == 0) {
-		return -1;
+	hex_extent_t *ext = image->extents;
+	unsigned int i;
+	for (i = 0; i < image->extent_count; i++) {
+		if (start <= ext[i].end && end >= ext[i].start) {
+			if (start < ext[i].start) ext[i].start = start;
+			if (end > ext[i].end) ext[i].end = end;
+			return;
+		}
 	}
-	fin = fopen(filename, "r");
-	if (fin == NULL) {
-		printf("   Can't open file '%s' for reading.\n", filename);
-		return -1;
+	if (image->extent_count == HEX_EXTENT_MAX) {
+		/* out of slots, widen the last extent to stay conservative */
+		i = image->extent_count - 1;
+		if (start < ext[i].start) ext[i].start = start;
+		if (end > ext[i].end) ext[i].end = end;
+		return;
 	}
-	while (!feof(fin) && !ferror(fin)) {
-		line[0] = '\0';
-		fgets(line, 1000, fin);
-		if (line[strlen(line)-1] == '\n') line[strlen(line)-1] = '\0';
-		if (line[strlen(line)-1] == '\r') line[strlen(line)-1] = '\0';
-		if (parse_hex_line(line, bytes, &addr, &n, &status)) {
+	ext[image->extent_count].start = start;
+	ext[image->extent_count].end = end;
+	image->extent_count++;
+}
+
+/* loads intel hex text held in data[0..size) into image->memory[] */
+/* name is used in error messages only */
+/* bytes not covered by the file are left in erased (0xFF) state, */
+/* covered ranges are recorded in image->extents[] */
+int load_hex_buffer(stc_image_t *image, const char *data, size_t size, const char *name)
+{
+	const char *line = data, *end = data + size, *eol;
+	uint8_t bytes[255];
+	size_t len;
+	int addr, n, status;
+	int total=0, lineno=1;
+	int minaddr=65536, maxaddr=0;
+
+	memset(image->memory, 0xFF, sizeof(image->memory));
+	image->extent_count = 0;
+	for (; line < end; line = eol + 1, lineno++) {
+		eol = memchr(line, '\n', end - line);
+		if (eol == NULL) eol = end;
+		len = eol - line;
+		while (len && isspace((unsigned char)line[len-1])) len--;
+		if (len == 0) continue;
+		if (hex_record_parse(line, len, bytes, &addr, &n, &status)) {
 			if (status == 0) {  /* data */
-				for(i=0; i<=(n-1); i++) {
-					memory[addr] = bytes[i] & 0xFF;
-					total++;
+				if (addr + n > (int)sizeof(image->memory)) {
+					printf("   Error: '%s', line: %d out of range\n", name, lineno);
+					return -1;
+				}
+				if (n > 0) {
+					hex_extent_add(image, addr, addr + n);
+					memcpy(image->memory + addr, bytes, n);
+					total += n;
 					if (addr < minaddr) minaddr = addr;
-					if (addr > maxaddr) maxaddr = addr;
-					addr++;
+					if (addr + n - 1 > maxaddr) maxaddr = addr + n - 1;
 				}
 			}
 			if (status == 1) {  /* end of file */
-				fclose(fin);
 				printf("   Loaded %d bytes between:", total);
-				printf(" %04X to %04X\n", minaddr, maxaddr);
+				printf(" %04X to %04X, %u data ranges\n", minaddr, maxaddr, image->extent_count);
                 if (debug)
                 {
                     for (int i = minaddr; i <= maxaddr; i++)
                     {
-                        printf("%02X ", memory[i]);
+                        printf("%02X ", image->memory[i]);
                     }
                     printf("\n");
                 }
@@ -538,9 +1416,345 @@ int load_hex_file(char *filename)
 			}
 			if (status == 2) {}  /* begin of file */
 		} else {
-			printf("   Error: '%s', line: %d\n", filename, lineno);
+			printf("   Error: '%s', line: %d\n", name, lineno);
 		}
-		lineno++;
 	}
-    return -1;
+	return -1;
+}
+
+/* loads an intel hex file into image->memory[] */
+/* filename is a string of the file to be opened */
+/* the file is parsed straight from a read-only mapping, */
+/* with a plain read as fallback where it can not be mapped */
+int load_hex_file(stc_image_t *image, char *filename)
+{
+	struct stat st;
+	char *data;
+	bool mapped = true;
+	int fd, ret;
+
+	if (strlen(filename) == 0) {
+		return -1;
+	}
+	fd = open(filename, O_RDONLY);
+	if (fd < 0 || fstat(fd, &st) < 0) {
+		printf("   Can't open file '%s' for reading: %s\n", filename, strerror(errno));
+		if (fd >= 0) close(fd);
+		return -1;
+	}
+	if (st.st_size == 0) {
+		printf("   Error: '%s' is empty\n", filename);
+		close(fd);
+		return -1;
+	}
+	data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (data == MAP_FAILED) {
+		mapped = false;
+		data = malloc(st.st_size);
+		if (data == NULL || read(fd, data, st.st_size) != st.st_size) {
+			printf("   Can't read file '%s'.\n", filename);
+			free(data);
+			close(fd);
+			return -1;
+		}
+	}
+	close(fd);
+	ret = load_hex_buffer(image, data, st.st_size, filename);
+	if (mapped) {
+		munmap(data, st.st_size);
+	} else {
+		free(data);
+	}
+	return ret;
+}
+
+uint64_t image_hash(const uint8_t *data, size_t size)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ data[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+/* stored structures start at multiples of this */
+#define STCIMG_ALIGN    8
+
+static uint32_t stcimg_align(uint32_t offset)
+{
+    return (offset + STCIMG_ALIGN - 1) & ~(uint32_t)(STCIMG_ALIGN - 1);
+}
+
+/***
+ * @brief write zeroes up to the next aligned offset
+ * @param out           - [in] compiled image file
+ * @param size          - [in] count of zeroes, less than STCIMG_ALIGN
+ * 
+ * @return              - true if written
+ */ 
+static bool stcimg_pad(FILE *out, uint32_t size)
+{
+    static const uint8_t pad[STCIMG_ALIGN];
+    return 0 == size || 1 == fwrite(pad, size, 1, out);
+}
+
+int save_image_file(const char *path, const stc_image_t *image, unsigned int len,
+                    const stc_frames_t *frames, uint16_t magic_code, uint16_t protocol)
+{
+    stcimg_header_t header;
+    uint32_t offset;
+    FILE *out;
+    bool ok;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, STCIMG_MAGIC, sizeof(header.magic));
+    header.version = STCIMG_VERSION;
+    header.byte_order = STCIMG_ORDER;
+    header.header_size = sizeof(header);
+    header.image_size = sizeof(*image);
+    header.frame_size = sizeof(stc_frame_t);
+    header.hash = image_hash(image->memory, len);
+    header.len = len;
+    header.magic_code = magic_code;
+    header.protocol = protocol;
+    header.image_offset = offset = stcimg_align(sizeof(header));
+    offset = stcimg_align(offset + sizeof(*image));
+    if (frames && frames->data && frames->count)
+    {
+        header.frames_offset = offset;
+        header.frame_count = frames->count;
+        header.frame_data_offset = offset = stcimg_align(offset + frames->count * sizeof(stc_frame_t));
+        header.frame_data_size = frames->first + FLASH_WRITE_HEAD
+                                 + frames->frames[0].len + FRAME_OVERHEAD;
+        offset = stcimg_align(offset + header.frame_data_size);
+        header.frames_first = frames->first;
+        header.frames_total = frames->total;
+        header.block_size = frames->block_size;
+        memcpy(header.flash_write, frames->flash_write, sizeof(header.flash_write));
+        header.skip_erased = frames->skip_erased;
+    }
+    header.file_size = offset;
+    header.header_sum = image_hash((const uint8_t *)&header, offsetof(stcimg_header_t, header_sum));
+
+    if (!(out = fopen(path, "wb")))
+    {
+        return -1;
+    }
+    ok = fwrite(&header, sizeof(header), 1, out) == 1
+         && stcimg_pad(out, header.image_offset - sizeof(header))
+         && fwrite(image, sizeof(*image), 1, out) == 1;
+    if (ok && header.frame_count)
+    {
+        offset = header.image_offset + sizeof(*image);
+        ok = stcimg_pad(out, header.frames_offset - offset)
+             && fwrite(frames->frames, sizeof(stc_frame_t), frames->count, out) == frames->count;
+        offset = header.frames_offset + frames->count * sizeof(stc_frame_t);
+        ok = ok && stcimg_pad(out, header.frame_data_offset - offset)
+             && fwrite(frames->data, header.frame_data_size, 1, out) == 1;
+        offset = header.frame_data_offset + header.frame_data_size;
+    }
+    else
+    {
+        offset = header.image_offset + sizeof(*image);
+    }
+    ok = ok && stcimg_pad(out, header.file_size - offset);
+    if (fclose(out) || !ok)
+    {
+        remove(path);
+        return -1;
+    }
+    return header.file_size;
+}
+
+/***
+ * @brief check the records behind a compiled image header, the image
+ *        data itself is only covered by the hash
+ * @param map           - [in] mapped file, header checked
+ * 
+ * @return              - true if every extent and frame lies where it may
+ */ 
+static bool stcimg_records_valid(const uint8_t *map)
+{
+    const stcimg_header_t *header = (const stcimg_header_t *)map;
+    const stc_image_t *image = (const stc_image_t *)(map + header->image_offset);
+    const stc_frame_t *frames = (const stc_frame_t *)(map + header->frames_offset);
+    uint64_t total = 0;
+
+    if (image->extent_count > HEX_EXTENT_MAX)
+    {
+        return false;
+    }
+    for (unsigned int i = 0; i < image->extent_count; i++)
+    {
+        if (image->extents[i].start > image->extents[i].end || image->extents[i].end > header->len)
+        {
+            return false;
+        }
+    }
+    if (header->frame_count == 0)
+    {
+        return true;
+    }
+    if (header->block_size < 1 || header->block_size > FLASH_BLOCK_MAX
+        || (uint64_t)header->frames_first + FLASH_WRITE_HEAD + frames[0].len + FRAME_OVERHEAD
+           > header->frame_data_size)
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < header->frame_count; i++)
+    {
+        if ((uint64_t)frames[i].offset + FLASH_WRITE_HEAD + frames[i].len + FRAME_OVERHEAD
+            > header->frame_data_size
+            || frames[i].len > header->block_size
+            || (uint32_t)frames[i].addr + frames[i].len > header->len)
+        {
+            return false;
+        }
+        total += frames[i].len;
+    }
+    return total == header->frames_total;
+}
+
+/***
+ * @brief check the image data against its hash, and the data of every
+ *        frame against the image, records checked
+ * @param map           - [in] mapped file
+ * 
+ * @return              - true if the data is what was compiled
+ */ 
+static bool stcimg_data_valid(const uint8_t *map)
+{
+    const stcimg_header_t *header = (const stcimg_header_t *)map;
+    const stc_image_t *image = (const stc_image_t *)(map + header->image_offset);
+    const stc_frame_t *frames = (const stc_frame_t *)(map + header->frames_offset);
+    const uint8_t *data = map + header->frame_data_offset;
+    /* block data follows prefix, length and write command */
+    const uint32_t skip = sizeof(tx_prefix) + 1 + FLASH_WRITE_HEAD;
+
+    if (header->hash != image_hash(image->memory, header->len))
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < header->frame_count; i++)
+    {
+        if (memcmp(data + frames[i].offset + skip, image->memory + frames[i].addr, frames[i].len))
+        {
+            return false;
+        }
+    }
+    return header->frame_count == 0
+           || !memcmp(data + header->frames_first + skip, image->memory + frames[0].addr,
+                      frames[0].len);
+}
+
+bool image_file_compiled(const char *path)
+{
+    char magic[sizeof(((stcimg_header_t *)0)->magic)];
+    int fd = open(path, O_RDONLY);
+    bool ret;
+
+    if (fd < 0)
+    {
+        return false;
+    }
+    ret = read(fd, magic, sizeof(magic)) == sizeof(magic)
+          && !memcmp(magic, STCIMG_MAGIC, sizeof(magic));
+    close(fd);
+    return ret;
+}
+
+int load_image_file(stc_compiled_t *compiled, const char *path, bool verify)
+{
+    const stcimg_header_t *header;
+    struct stat st;
+    uint8_t *map;
+    int fd;
+
+    memset(compiled, 0, sizeof(*compiled));
+    if ((fd = open(path, O_RDONLY)) < 0)
+    {
+        return -1;
+    }
+    if (fstat(fd, &st) < 0)
+    {
+        close(fd);
+        return -1;
+    }
+    if (st.st_size < (off_t)sizeof(stcimg_header_t))
+    {
+        close(fd);
+        return -2;
+    }
+    map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        return -1;
+    }
+
+    /* the header is checked first, it locates everything else */
+    header = (const stcimg_header_t *)map;
+    if (memcmp(header->magic, STCIMG_MAGIC, sizeof(header->magic)))
+    {
+        munmap(map, st.st_size);
+        return -2;
+    }
+    if (header->version != STCIMG_VERSION
+        || header->byte_order != STCIMG_ORDER
+        || header->header_size != sizeof(*header)
+        || header->image_size != sizeof(stc_image_t)
+        || header->frame_size != sizeof(stc_frame_t)
+        || header->header_sum != image_hash(map, offsetof(stcimg_header_t, header_sum))
+        || header->file_size != (uint64_t)st.st_size
+        || header->len > sizeof(((stc_image_t *)0)->memory)
+        || header->image_offset % STCIMG_ALIGN
+        || (uint64_t)header->image_offset + sizeof(stc_image_t) > header->file_size
+        || (header->frame_count
+            && (header->frames_offset % STCIMG_ALIGN
+                || header->frame_data_offset % STCIMG_ALIGN
+                || (uint64_t)header->frames_offset + (uint64_t)header->frame_count
+                   * sizeof(stc_frame_t) > header->frame_data_offset
+                || (uint64_t)header->frame_data_offset + header->frame_data_size
+                   > header->file_size
+                || (uint64_t)header->frames_first + FLASH_WRITE_HEAD + FRAME_OVERHEAD
+                   > header->frame_data_size))
+        || !stcimg_records_valid(map))
+    {
+        munmap(map, st.st_size);
+        return -3;
+    }
+    if (verify && !stcimg_data_valid(map))
+    {
+        munmap(map, st.st_size);
+        return -4;
+    }
+
+    compiled->map = map;
+    compiled->map_size = st.st_size;
+    compiled->header = header;
+    compiled->image = (const stc_image_t *)(map + header->image_offset);
+    if (header->frame_count)
+    {
+        /* never written through, the mapping is read-only */
+        compiled->frames.data = map + header->frame_data_offset;
+        compiled->frames.frames = (stc_frame_t *)(map + header->frames_offset);
+        compiled->frames.count = header->frame_count;
+        compiled->frames.total = header->frames_total;
+        compiled->frames.first = header->frames_first;
+        memcpy(compiled->frames.flash_write, header->flash_write, sizeof(header->flash_write));
+        compiled->frames.len = header->len;
+        compiled->frames.block_size = header->block_size;
+        compiled->frames.skip_erased = header->skip_erased;
+    }
+    return header->len;
+}
+
+void unload_image_file(stc_compiled_t *compiled)
+{
+    if (compiled->map)
+    {
+        munmap(compiled->map, compiled->map_size);
+    }
+    memset(compiled, 0, sizeof(*compiled));
 }
@@ -22,9 +22,145 @@
 #include <ctype.h>
 #include "stc8db.h"
 #include "userial.h"
+#include "rxthread.h"
 
-/* OS-abstract serial instance */
-extern userial_t serial;
+/* maximum count of separate data ranges tracked for a loaded image */
+#define HEX_EXTENT_MAX 64
+
+/* address range [start, end) holding data of the loaded image */
+typedef struct {
+    uint32_t start;
+    uint32_t end;
+} hex_extent_t;
+
+/* protocol counters, for reporting */
+typedef struct {
+    uint32_t detect_tries;      /* handshake bytes sent until chip answered */
+    uint32_t read_retries;      /* command replies timed out */
+    uint32_t blocks;            /* flash blocks acknowledged */
+    uint32_t bytes;             /* flash data bytes acknowledged */
+    uint32_t write_retries;     /* flash write retransmission rounds */
+    uint32_t resent_blocks;     /* flash blocks sent again */
+    uint32_t downshifts;        /* baud rate lowered during the write */
+    uint32_t replies;           /* command replies received */
+    uint64_t reply_us;          /* sum of times from last send to reply */
+    uint32_t turnarounds;       /* write frames queued right after an ACK */
+    uint64_t turnaround_us;     /* sum of times from ACK arrival to next frame */
+    uint64_t turnaround_max_us;
+    uint64_t ack_us;            /* sum of times from write frame to its ACK */
+} stc_stats_t;
+
+/* bytes of a frame around its payload: prefix, length, checksum and suffix */
+#define FRAME_OVERHEAD 8
+/* longest payload, the length byte counts the frame without its first
+ * 2 bytes */
+#define FRAME_PAYLOAD_MAX (255 + 2 - FRAME_OVERHEAD)
+
+/* reentrant decoder of chip response frames, one per port */
+typedef struct {
+    uint8_t buf[2 * 256];       /* received bytes not consumed yet */
+    uint16_t len;
+    uint32_t errors;            /* frames dropped on checksum mismatch */
+} frame_decoder_t;
+
+/* firmware image, as loaded by load_hex_file() */
+typedef struct {
+    uint8_t memory[65536];      /* flash content, 0xFF where not covered */
+    hex_extent_t extents[HEX_EXTENT_MAX];
+    unsigned int extent_count;
+} stc_image_t;
+
+/* write frame of one flash block, see stc_frames_t */
+typedef struct {
+    uint32_t offset;            /* start of the frame in the frame data */
+    uint16_t addr;              /* block address */
+    uint16_t len;               /* block data bytes */
+} stc_frame_t;
+
+/* write frames of an image, built once by flash_frames_build() and sent
+ * as they are by every session writing the image */
+typedef struct {
+    uint8_t *data;              /* framed write commands back to back */
+    stc_frame_t *frames;        /* blocks in write order */
+    unsigned int count;
+    unsigned int total;         /* data bytes of all blocks */
+    uint32_t first;             /* frame of block 0 as the first command */
+    /* what the frames were built for, flash_write() checks it */
+    uint8_t flash_write[sizeof(((stc_protocol_t *)0)->flash_write)];
+    unsigned int len;
+    unsigned int block_size;
+    bool skip_erased;
+} stc_frames_t;
+
+/* compiled image file written by save_image_file(), the image and the
+ * frames are stored as the structures they are loaded into, so the file
+ * is tied to the byte order and structure sizes recorded in the header */
+#define STCIMG_MAGIC        "STCI"
+#define STCIMG_VERSION      1
+#define STCIMG_ORDER        0x0102
+
+typedef struct {
+    char magic[4];
+    uint16_t version;
+    uint16_t byte_order;
+    uint32_t header_size;
+    uint32_t image_size;        /* sizeof(stc_image_t) */
+    uint32_t frame_size;        /* sizeof(stc_frame_t) */
+    uint32_t file_size;
+    uint64_t hash;              /* FNV-1a of the image up to len */
+    uint32_t len;               /* image length, as from load_hex_file() */
+    uint16_t magic_code;        /* chip the image is for, 0 for any */
+    uint16_t protocol;          /* protocol the image is for, 0 for any */
+    uint32_t image_offset;
+    /* prepared write frames, frame_count 0 if there are none */
+    uint32_t frames_offset;
+    uint32_t frame_count;
+    uint32_t frame_data_offset;
+    uint32_t frame_data_size;
+    uint32_t frames_first;
+    uint32_t frames_total;
+    uint32_t block_size;
+    uint8_t flash_write[sizeof(((stc_protocol_t *)0)->flash_write)];
+    uint8_t skip_erased;
+    uint64_t header_sum;        /* FNV-1a of the header up to here */
+} stcimg_header_t;
+
+/* compiled image mapped by load_image_file() */
+typedef struct {
+    void *map;
+    size_t map_size;
+    const stcimg_header_t *header;
+    const stc_image_t *image;
+    stc_frames_t frames;        /* data is NULL if the file holds none */
+} stc_compiled_t;
+
+/* state of programming one chip, sessions share nothing but the image */
+typedef struct {
+    userial_t *port;            /* opened by the caller */
+    rx_thread_t *rx;            /* reads the port in the background,
+                                   NULL to read it on demand */
+    uint64_t tx_time_us;        /* last frame queued */
+    uint64_t rx_time_us;        /* arrival of the data last decoded */
+    const stc_image_t *image;
+    const stc_frames_t *frames; /* prepared write frames of the image,
+                                   NULL to frame blocks while writing */
+    frame_decoder_t decoder;
+    bool debug;                 /* dump frames to stdout */
+    unsigned int block_size;    /* data bytes per write frame */
+    unsigned int window;        /* write frames sent ahead of their ACK,
+                                   1 is plain stop-and-wait */
+    uint32_t read_idle_ms;      /* reply wait before a read gives up */
+    uint32_t read_gap_ms;       /* wait for the rest of a started frame
+                                   beyond the wire time of the longest */
+    uint32_t reply_margin_ms;   /* reply wait on top of wire and chip time */
+    uint32_t fosc;              /* chip clock the baud divisors are based on */
+    const stc_model_t *model;   /* detected chip, sizes flash timeouts */
+    bool downshift;             /* lower the baud rate on write errors
+                                   instead of failing */
+    uint8_t info[255];          /* detect reply, baud switches take
+                                   arguments from it */
+    stc_stats_t stats;
+} stc_session_t;
 
 typedef unsigned char BYTE;
 typedef unsigned short WORD;
@@ -33,38 +169,283 @@ typedef unsigned short WORD;
 #define HIBYTE(w) ((BYTE)((WORD)(w) >> 8))
 
 #define FUSER 24000000L             // STC8H MCU default frequency
-#define RL(n) (65536 - FUSER/4/(n)) // STC8H UART baudrate calculator
+/* plausible range of the IRC frequency reported by the chip */
+#define FOSC_MIN 1000000L
+#define FOSC_MAX 64000000L
 
 #define MINBAUD 2400
 #define MAXBAUD 115200
 
-#define DEBUG_PRINTF(...) if(debug){printf(__VA_ARGS__);}
+/* flash write block size in bytes, bounded by the 255 byte frame */
+#define FLASH_BLOCK_DEFAULT 128
+#define FLASH_BLOCK_MAX     242
+/* maximum count of unacknowledged write frames */
+#define FLASH_WINDOW_MAX    4
+
+#define DEBUG_PRINTF(...) if(session->debug){printf(__VA_ARGS__);}
 
 /* stc8prog.c */
 
+/***
+ * @brief initialize session with default settings
+ * @param session       - [out] session to initialize
+ * @param port          - [in] opened serial port
+ * @param image         - [in] image to be written, may be NULL
+ */ 
+extern void stc_session_init(stc_session_t *session, userial_t *port,
+                             const stc_image_t *image);
+
 /***
  * @brief detect chip
+ * @param session       - [inout] programming session
  * @param recv          - [out] chip detect data destination
  * @param retry_count   - [in] handshake retry count
  * 
  * @return              - 0 if chip detected,
  *                        error code otherwise
  */ 
-extern int32_t chip_detect(uint8_t * restrict const recv,
+extern int32_t chip_detect(stc_session_t *session,
+                           uint8_t * restrict const recv,
                            const uint16_t retry_count);
 
 extern void set_debug(uint8_t val);
-extern int baudrate_set(const stc_protocol_t * stc_protocol, unsigned int speed, uint8_t *recv);
-extern int baudrate_check(const stc_protocol_t * stc_protocol, uint8_t *recv, uint8_t chip_version);
-extern int flash_erase(const stc_protocol_t * stc_protocol, uint8_t *recv);
-extern int flash_write(const stc_protocol_t * stc_protocol, unsigned int len);
+extern uint64_t monotonic_ms(void);
+extern uint64_t monotonic_us(void);
+/***
+ * @brief decode the IRC frequency from the chip detect data
+ * @param stc_protocol  - [in] chip protocol
+ * @param recv          - [in] chip detect data
+ * 
+ * @return              - frequency in Hz, 0xFFFFFFFF if unadjusted
+ */ 
+extern uint32_t chip_info_fosc(const stc_protocol_t * stc_protocol, const uint8_t *recv);
 
-extern int chip_write(uint8_t *buff, uint8_t len);
-extern int chip_read(uint8_t *recv);
+/***
+ * @brief baud rate the chip UART really runs at for a requested rate
+ * @param stc_protocol  - [in] chip protocol
+ * @param fosc          - [in] chip clock
+ * @param speed         - [in] requested baud rate
+ * 
+ * @return              - actual rate, 0 if speed can not be reached
+ */ 
+extern unsigned int baudrate_actual(const stc_protocol_t * stc_protocol,
+                                    uint32_t fosc, unsigned int speed);
+
+/***
+ * @brief find the fastest rate the chip UART hits within tolerance
+ * @param stc_protocol  - [in] chip protocol
+ * @param fosc          - [in] chip clock
+ * @param max_speed     - [in] requested rate, tried first
+ * 
+ * @return              - max_speed or the fastest standard rate below it,
+ *                        0 if none is usable
+ */ 
+extern unsigned int baudrate_plan(const stc_protocol_t * stc_protocol, uint32_t fosc,
+                                  unsigned int max_speed);
+
+/***
+ * @brief find the host rate matching the chip rate set for a requested rate,
+ *        the port is probed and left at its current rate
+ * @param session       - [inout] programming session
+ * @param stc_protocol  - [in] chip protocol
+ * @param speed         - [in] rate passed to baudrate_set()
+ * 
+ * @return              - exact chip rate if the port can do it, speed if
+ *                        that is within tolerance, 0 if the port can't follow
+ */ 
+extern unsigned int baudrate_match(stc_session_t *session, const stc_protocol_t * stc_protocol,
+                                   unsigned int speed);
+
+extern int baudrate_set(stc_session_t *session, const stc_protocol_t * stc_protocol,
+                        unsigned int speed, uint8_t *recv);
+extern int baudrate_check(stc_session_t *session, const stc_protocol_t * stc_protocol,
+                          uint8_t *recv, uint8_t chip_version);
+
+/***
+ * @brief find the next slower standard rate
+ * @param speed         - [in] rate to go below
+ * 
+ * @return              - fastest standard rate off speed by more than the
+ *                        chip rate tolerance, 0 if there is none
+ */ 
+extern unsigned int baudrate_next(unsigned int speed);
+
+/* brings a chip that took a rate the line does not carry back to the
+ * handshake, port is at that rate on the call, returns 0 once the chip
+ * answered again with its detect data in recv */
+typedef int (*stc_reinvite_t)(stc_session_t *session, uint8_t *recv);
+
+/***
+ * @brief find the fastest rate the chip passes a stress ping at,
+ *        walking down the standard rates
+ * @param session       - [inout] programming session, port at handshake rate
+ * @param stc_protocol  - [in] chip protocol
+ * @param recv          - [inout] chip detect data, last reply on return
+ * @param chip_version  - [in] chip firmware version
+ * @param max_speed     - [in] first rate to try
+ * @param pings         - [in] count of checks that all have to pass
+ * @param reinvite      - [in] called when the chip took a rate failing the
+ *                        pings, the next rate is tried from the handshake
+ *                        then, NULL to send it at the failed rate
+ * 
+ * @return              - negotiated host rate, port and chip are left at it,
+ *                        negative error code if no rate works
+ */ 
+extern int baudrate_negotiate(stc_session_t *session, const stc_protocol_t * stc_protocol,
+                              uint8_t *recv, uint8_t chip_version,
+                              unsigned int max_speed, unsigned int pings,
+                              stc_reinvite_t reinvite);
+extern int flash_erase(stc_session_t *session, const stc_protocol_t * stc_protocol,
+                       uint8_t *recv);
+
+/***
+ * @brief write the session image to flash, using session block size and window
+ * @param session       - [inout] programming session
+ * @param stc_protocol  - [in] chip protocol
+ * @param len           - [in] image length
+ * @param skip_erased   - [in] chip was erased, skip blocks holding only 0xFF
+ * 
+ * @return              - 0 on success, error code otherwise
+ */ 
+extern int flash_write(stc_session_t *session, const stc_protocol_t * stc_protocol,
+                       unsigned int len, bool skip_erased);
+
+/***
+ * @brief frame the write commands of an image once, for flash_write() of
+ *        any session with the same parameters to send without rebuilding
+ * @param frames        - [out] prepared frames, release with flash_frames_free()
+ * @param image         - [in] image to be written
+ * @param stc_protocol  - [in] protocol the write command is taken from
+ * @param len           - [in] image length
+ * @param block_size    - [in] data bytes per write frame
+ * @param skip_erased   - [in] skip blocks holding only 0xFF
+ * 
+ * @return              - number of frames, negative if out of memory
+ */ 
+extern int flash_frames_build(stc_frames_t *frames, const stc_image_t *image,
+                              const stc_protocol_t * stc_protocol, unsigned int len,
+                              unsigned int block_size, bool skip_erased);
+
+/***
+ * @brief release frames built by flash_frames_build()
+ * @param frames        - [inout] prepared frames
+ */ 
+extern void flash_frames_free(stc_frames_t *frames);
+
+/***
+ * @brief wrap command into a complete frame ready to send
+ * @param dst           - [out] frame destination, at least len + 8 bytes
+ * @param buff          - [in] command payload
+ * @param len           - [in] command payload length
+ * 
+ * @return              - frame length
+ */ 
+extern uint8_t frame_build(uint8_t *dst, const uint8_t *buff, uint8_t len);
+
+/***
+ * @brief send a command to the chip
+ * @param session       - [inout] programming session
+ * @param buff          - [in] command payload
+ * @param len           - [in] command payload length
+ * 
+ * @return              - 0 on success, negative error code of the port
+ */ 
+extern int chip_write(stc_session_t *session, uint8_t *buff, uint8_t len);
+
+/***
+ * @brief drop all buffered data of frame decoder
+ * @param dec           - [inout] frame decoder
+ */ 
+extern void frame_decoder_reset(frame_decoder_t *dec);
+
+/***
+ * @brief append received bytes to frame decoder
+ * @param dec           - [inout] frame decoder
+ * @param src           - [in] received bytes
+ * @param size          - [in] count of received bytes
+ * 
+ * @return              - count of bytes accepted, the decoder always has
+ *                        room for 255 bytes after frame_decoder_next()
+ */ 
+extern uint32_t frame_decoder_feed(frame_decoder_t *dec, const uint8_t *src, uint32_t size);
+
+/***
+ * @brief extract next complete and valid frame from frame decoder
+ * @param dec           - [inout] frame decoder
+ * @param payload       - [out] frame payload destination, at least
+ *                        FRAME_PAYLOAD_MAX bytes
+ * 
+ * @return              - payload length, 0 if no complete frame is buffered
+ */ 
+extern int frame_decoder_next(frame_decoder_t *dec, uint8_t *payload);
+extern int chip_read(stc_session_t *session, uint8_t *recv);
 extern int chip_read_verify(uint8_t *buf, uint8_t size, uint8_t *recv);
 
-extern int load_hex_file(char *filename);
+extern int load_hex_file(stc_image_t *image, char *filename);
+
+/***
+ * @brief FNV-1a hash of image data, identifies compiled images
+ * @param data          - [in] data
+ * @param size          - [in] data length
+ * 
+ * @return              - hash
+ */ 
+extern uint64_t image_hash(const uint8_t *data, size_t size);
+
+/***
+ * @brief write an image and optionally its prepared frames to a compiled
+ *        image file
+ * @param path          - [in] file to write
+ * @param image         - [in] loaded image
+ * @param len           - [in] image length
+ * @param frames        - [in] frames built for the image, may be NULL
+ * @param magic_code    - [in] chip the image is for, 0 for any
+ * @param protocol      - [in] protocol the image is for, 0 for any
+ * 
+ * @return              - file size, negative on error
+ */ 
+extern int save_image_file(const char *path, const stc_image_t *image, unsigned int len,
+                           const stc_frames_t *frames, uint16_t magic_code, uint16_t protocol);
+
+/***
+ * @brief check if a file starts like a compiled image
+ * @param path          - [in] file to look at
+ * 
+ * @return              - true if it carries the compiled image magic,
+ *                        false if it does not or can not be read
+ */ 
+extern bool image_file_compiled(const char *path);
+
+/***
+ * @brief map a compiled image file, its header, extents and frame records
+ *        are checked, release with unload_image_file()
+ * @param compiled      - [out] mapped image and frames
+ * @param path          - [in] file written by save_image_file()
+ * @param verify        - [in] also compare the image data with its hash
+ * 
+ * @return              - image length, -1 if the file can not be mapped,
+ *                        -2 if it is no compiled image, -3 if it is
+ *                        damaged or written by an incompatible build,
+ *                        -4 if image or frame data does not match the hash
+ */ 
+extern int load_image_file(stc_compiled_t *compiled, const char *path, bool verify);
+extern void unload_image_file(stc_compiled_t *compiled);
+extern int load_hex_buffer(stc_image_t *image, const char *data, size_t size, const char *name);
 extern int parse_hex_line(char *theline, int bytes[], int *addr, int *num, int *code);
 
+/***
+ * @brief decode one Intel HEX record in a single pass
+ * @param line          - [in] record text, need not be NUL terminated
+ * @param size          - [in] record text length without line ending
+ * @param bytes         - [out] record data, at least 255 bytes
+ * @param addr          - [out] record address
+ * @param num           - [out] count of data bytes
+ * @param code          - [out] record type
+ * 
+ * @return              - 1 if the record is valid, 0 otherwise
+ */ 
+extern int hex_record_parse(const char *line, size_t size, uint8_t *bytes,
+                            int *addr, int *num, int *code);
+
 
 #endif  /* __STC8PROG_H__ */
@@ -132,6 +132,46 @@ typedef int32_t (*userial_write_t)(struct userial * restrict const this,
                                   const uint8_t * restrict const src,
                                   const uint32_t src_siz);
 
+/* one of the buffers written in order by userial_writev_t */
+typedef struct {
+    const uint8_t *data;
+    uint32_t size;
+} userial_segment_t;
+
+/***
+ * @brief write several buffers to serial port as one transfer
+ * @param this      - [inout] serial port instance
+ * @param segs      - [in] buffers to write, in order
+ * @param count     - [in] buffer count
+ * 
+ * @return          - write data count on success, error code otherwise 
+ */ 
+typedef int32_t (*userial_writev_t)(struct userial * restrict const this,
+                                    const userial_segment_t * restrict const segs,
+                                    const uint32_t count);
+
+/***
+ * @brief wait until everything written has left the serial port
+ * @param this        - [inout] serial port instance
+ * @param timeout_ms  - [in] give up if the output queue does not shrink
+ *                      for this time, in milliseconds
+ * 
+ * @return            - 0 on success, error code otherwise 
+ */ 
+typedef int32_t (*userial_drain_t)(struct userial * restrict const this,
+                                   const uint32_t timeout_ms);
+
+/***
+ * @brief wait until data is available for reading from serial port
+ * @param this        - [inout] serial port instance
+ * @param timeout_ms  - [in] maximum time to wait in milliseconds
+ * 
+ * @return            - positive if data is ready, 0 on timeout,
+ *                      error code otherwise 
+ */ 
+typedef int32_t (*userial_wait_readable_t)(struct userial * restrict const this,
+                                           const uint32_t timeout_ms);
+
 /***
  * @struct unified serial port instance, generic type for access the serial port
  */ 
@@ -146,6 +186,9 @@ typedef struct userial {
     userial_dtr_set_t dtr_set;      /* set level on dtr line */
     userial_read_t read;            /* read data from serial port */
     userial_write_t write;          /* write data from serial port */
+    userial_writev_t writev;        /* write several buffers at once */
+    userial_drain_t drain;          /* wait for written data to be sent */
+    userial_wait_readable_t wait_readable; /* wait for incoming data */
     /* unified serial port parameters */
     uint8_t name[SERIAL_PORT_PATH_MAX];
     uint32_t initiated;
@@ -153,6 +196,21 @@ typedef struct userial {
     uint8_t databits;
     uint8_t stopbits;
     userial_parity_t parity;
+    bool tx_queue;                  /* writes return once data is queued,
+                                       not once it is sent */
 } userial_t;
 
+/***
+ * @brief allocate serial port instance of the platform backend
+ * 
+ * @return          - closed serial port instance, NULL if out of memory
+ */ 
+extern userial_t *userial_alloc(void);
+
+/***
+ * @brief close serial port and release its instance
+ * @param port      - [inout] instance returned by userial_alloc()
+ */ 
+extern void userial_free(userial_t *port);
+
 #endif
\ No newline at end of file
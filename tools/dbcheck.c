@@ -0,0 +1,75 @@
+// Copyright 2022 IOsetting <iosetting@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * Chip model table check, run by the build
+ *
+ * model_lookup() bisects the table, so every magic code has to be larger
+ * than the one before it. Also catches unnamed entries and unknown
+ * protocols. Exits non-zero on the first problem.
+ */
+
+#include <stdio.h>
+#include "stc8db.h"
+
+typedef struct {
+    const char *name;
+    unsigned int code;
+    unsigned int protocol;
+} entry_t;
+
+static const entry_t entries[] = {
+#define STC_MODEL(name, code, protocol, total, size, eeprom) {name, code, protocol},
+#include "stc8models.def"
+#undef STC_MODEL
+};
+
+int main(void)
+{
+    const size_t count = sizeof(entries) / sizeof(entries[0]);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const entry_t *e = &entries[i];
+        if (!e->name[0])
+        {
+            printf("stc8models.def: entry %zu (%04X) has no name\n", i, e->code);
+            return 1;
+        }
+        if (e->protocol != PROTOCOL_UNSUPP && !protocol_lookup(e->protocol))
+        {
+            printf("stc8models.def: %s has unknown protocol %04X\n", e->name, e->protocol);
+            return 1;
+        }
+        if (i > 0 && e->code == entries[i - 1].code)
+        {
+            printf("stc8models.def: %s and %s share code %04X, merge them\n",
+                   entries[i - 1].name, e->name, e->code);
+            return 1;
+        }
+        if (i > 0 && e->code < entries[i - 1].code)
+        {
+            printf("stc8models.def: %s (%04X) is not sorted, it goes before %s (%04X)\n",
+                   e->name, e->code, entries[i - 1].name, entries[i - 1].code);
+            return 1;
+        }
+        const stc_model_t *model = model_lookup(e->code);
+        if (!model || strcmp(model->name, e->name))
+        {
+            printf("stc8models.def: %s (%04X) not found by model_lookup()\n", e->name, e->code);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,181 @@
+// Copyright 2022 IOsetting <iosetting@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * Chip database generator, writes the file read by stc8prog --chip-db
+ *
+ *   dbgen [-a models.txt] output.db
+ *
+ * The built-in table is written as is, models listed with -a are added
+ * to it or replace the built-in model of the same code. One model per
+ * line, fields as in stc8models.def, '#' starts a comment:
+ *
+ *   STC8H8K64U  F784  1  65536  65024  0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include "stc8db.h"
+
+#define NAME_MAX_LEN    64
+
+typedef struct {
+    char name[NAME_MAX_LEN];
+    unsigned int code;
+    unsigned int protocol;
+    unsigned int total_flash;
+    unsigned int code_size;
+    unsigned int eeprom_size;
+} model_t;
+
+static const model_t builtin[] = {
+#define STC_MODEL(name, code, protocol, total, size, eeprom) \
+    {name, code, protocol, total, size, eeprom},
+#include "stc8models.def"
+#undef STC_MODEL
+};
+
+/* every magic code has a slot, the file is written in code order */
+static const model_t *table[UINT16_MAX + 1];
+
+static void usage(void)
+{
+    printf("Usage: dbgen [-a models.txt] output.db\n");
+    exit(1);
+}
+
+/***
+ * @brief add models listed in a text file, replacing built-in ones
+ * @param path          - [in] model list
+ *
+ * @return              - number of models read, -1 on error
+ */
+static int add_models(const char *path)
+{
+    static model_t added[UINT16_MAX + 1];
+    FILE *in = fopen(path, "r");
+    char line[256];
+    int line_no = 0, count = 0;
+    model_t m;
+
+    if (!in)
+    {
+        perror(path);
+        return -1;
+    }
+    while (fgets(line, sizeof(line), in))
+    {
+        char *comment = strchr(line, '#');
+
+        line_no++;
+        if (comment)
+        {
+            *comment = '\0';
+        }
+        if (strspn(line, " \t\r\n") == strlen(line))
+        {
+            continue;
+        }
+        if (sscanf(line, "%63s %x %i %u %u %u", m.name, &m.code, &m.protocol,
+                   &m.total_flash, &m.code_size, &m.eeprom_size) != 6
+            || m.code > UINT16_MAX
+            || (m.protocol != PROTOCOL_UNSUPP && !protocol_lookup(m.protocol)))
+        {
+            printf("%s:%d: expected: name code protocol total_flash code_size eeprom_size\n",
+                   path, line_no);
+            fclose(in);
+            return -1;
+        }
+        added[m.code] = m;
+        table[m.code] = &added[m.code];
+        count++;
+    }
+    fclose(in);
+    return count;
+}
+
+int main(int argc, char *argv[])
+{
+    stc_db_header_t header = {MODEL_DB_MAGIC, MODEL_DB_VERSION, MODEL_DB_ORDER,
+                              sizeof(stc_db_record_t), 0, 0, 0};
+    FILE *out;
+    int arg;
+
+    for (size_t i = 0; i < sizeof(builtin) / sizeof(builtin[0]); i++)
+    {
+        table[builtin[i].code] = &builtin[i];
+    }
+    while ((arg = getopt(argc, argv, "a:h")) != -1)
+    {
+        switch (arg)
+        {
+            case 'a':
+                if (add_models(optarg) < 0)
+                {
+                    return 1;
+                }
+                break;
+            default:
+                usage();
+        }
+    }
+    if (optind != argc - 1)
+    {
+        usage();
+    }
+
+    for (unsigned int code = 0; code <= UINT16_MAX; code++)
+    {
+        if (table[code])
+        {
+            header.count++;
+            header.names_size += strlen(table[code]->name) + 1;
+        }
+    }
+
+    if (!(out = fopen(argv[optind], "wb")))
+    {
+        perror(argv[optind]);
+        return 1;
+    }
+    fwrite(&header, sizeof(header), 1, out);
+    for (unsigned int code = 0, name = 0; code <= UINT16_MAX; code++)
+    {
+        const model_t *m = table[code];
+        if (m)
+        {
+            stc_db_record_t record = {m->code, m->protocol, name,
+                                      m->total_flash, m->code_size, m->eeprom_size};
+            fwrite(&record, sizeof(record), 1, out);
+            name += strlen(m->name) + 1;
+        }
+    }
+    for (unsigned int code = 0; code <= UINT16_MAX; code++)
+    {
+        if (table[code])
+        {
+            fwrite(table[code]->name, strlen(table[code]->name) + 1, 1, out);
+        }
+    }
+    if (fclose(out))
+    {
+        perror(argv[optind]);
+        return 1;
+    }
+    printf("%s: %u models, %zu bytes\n", argv[optind], header.count,
+           sizeof(header) + header.count * sizeof(stc_db_record_t) + header.names_size);
+    return 0;
+}
@@ -0,0 +1,143 @@
+// Copyright 2022 IOsetting <iosetting@outlook.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * Intel HEX parser micro-benchmark
+ *
+ * Decodes the records of a 64 KB image, held in memory, with the former
+ * sscanf based parser and with hex_record_parse(), checks both give the
+ * same data and prints the time per image for each of them.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "stc8prog.h"
+
+#define IMAGE_SIZE      65536
+#define RECORD_BYTES    16
+#define RECORD_COUNT    (IMAGE_SIZE / RECORD_BYTES)
+#define RECORD_LEN      (11 + RECORD_BYTES * 2)
+
+/* the parser as it was before the lookup table decoder */
+static int sscanf_parse_hex_line(char *theline, int bytes[], int *addr, int *num, int *code)
+{
+	int sum, len, cksum;
+	char *ptr;
+
+	*num = 0;
+	if (theline[0] != ':') return 0;
+	if (strlen(theline) < 11) return 0;
+	ptr = theline+1;
+	if (!sscanf(ptr, "%02x", &len)) return 0;
+	ptr += 2;
+	if ( strlen(theline) < (size_t)(11 + (len * 2)) ) return 0;
+	if (!sscanf(ptr, "%04x", addr)) return 0;
+	ptr += 4;
+	if (!sscanf(ptr, "%02x", code)) return 0;
+	ptr += 2;
+	sum = (len & 255) + ((*addr >> 8) & 255) + (*addr & 255) + (*code & 255);
+	while(*num != len) {
+		if (!sscanf(ptr, "%02x", &bytes[*num])) return 0;
+		ptr += 2;
+		sum += bytes[*num] & 255;
+		(*num)++;
+		if (*num >= 256) return 0;
+	}
+	if (!sscanf(ptr, "%02x", &cksum)) return 0;
+	if ( ((sum & 255) + (cksum & 255)) & 255 ) return 0; /* checksum error */
+	return 1;
+}
+
+/* writes a pseudo-random image to expect and its records to records */
+static void image_generate(char (*records)[RECORD_LEN + 1], uint8_t *expect)
+{
+	uint32_t seed = 0x12345678;
+	for (int r = 0; r < RECORD_COUNT; r++)
+	{
+		const int addr = r * RECORD_BYTES;
+		unsigned int sum = RECORD_BYTES + (addr >> 8) + (addr & 0xFF);
+		char *p = records[r];
+		p += sprintf(p, ":%02X%04X00", RECORD_BYTES, addr);
+		for (int i = 0; i < RECORD_BYTES; i++)
+		{
+			seed = seed * 1103515245 + 12345;
+			expect[addr + i] = seed >> 16;
+			sum += expect[addr + i];
+			/* mixed case, both have to be accepted */
+			p += sprintf(p, (i & 1) ? "%02x" : "%02X", expect[addr + i]);
+		}
+		sprintf(p, "%02X", (256 - (sum & 0xFF)) & 0xFF);
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	static char records[RECORD_COUNT][RECORD_LEN + 1];
+	static uint8_t expect[IMAGE_SIZE], image[IMAGE_SIZE];
+	const int rounds = argc > 1 ? atoi(argv[1]) : 20;
+	int bytes[256], addr, num, code;
+	uint8_t data[255];
+	uint64_t start, sscanf_us, lut_us;
+
+	image_generate(records, expect);
+
+	start = monotonic_us();
+	for (int n = 0; n < rounds; n++)
+	{
+		for (int r = 0; r < RECORD_COUNT; r++)
+		{
+			if (!sscanf_parse_hex_line(records[r], bytes, &addr, &num, &code))
+			{
+				printf("sscanf parser rejected record %d\n", r);
+				return 1;
+			}
+			for (int i = 0; i < num; i++)
+				image[addr + i] = bytes[i];
+		}
+	}
+	sscanf_us = monotonic_us() - start;
+	if (memcmp(image, expect, IMAGE_SIZE))
+	{
+		printf("sscanf parser image mismatch\n");
+		return 1;
+	}
+
+	memset(image, 0, IMAGE_SIZE);
+	start = monotonic_us();
+	for (int n = 0; n < rounds; n++)
+	{
+		for (int r = 0; r < RECORD_COUNT; r++)
+		{
+			if (!hex_record_parse(records[r], RECORD_LEN, data, &addr, &num, &code))
+			{
+				printf("table parser rejected record %d\n", r);
+				return 1;
+			}
+			memcpy(image + addr, data, num);
+		}
+	}
+	lut_us = monotonic_us() - start;
+	if (memcmp(image, expect, IMAGE_SIZE))
+	{
+		printf("table parser image mismatch\n");
+		return 1;
+	}
+
+	printf("64 KB image, %d records, %d rounds\n", RECORD_COUNT, rounds);
+	printf("  sscanf:       %8.1f us/image\n", (double)sscanf_us / rounds);
+	printf("  lookup table: %8.1f us/image\n", (double)lut_us / rounds);
+	printf("  speedup:      %8.1fx\n", lut_us ? (double)sscanf_us / lut_us : 0.0);
+	return 0;
+}